@@ -1,109 +1,68 @@
 /*
-* Descrição: Esta função calcula a interseção entre dois arrays de inteiros ordenando-os previamente
-* com Quick Sort e depois comparando os elementos com dois ponteiros. Isso reduz a complexidade do algoritmo.
+* Descrição: Esta função calcula a interseção entre dois arrays de inteiros com uma tabela hash, em
+* tempo linear: em vez de ordenar os dois arrays (O(n log n)), constrói a tabela com o menor e consulta
+* cada elemento do maior. Entradas grandes são particionadas para que cada tabela caiba na cache.
 * A interseção é retornada em um array alocado dinamicamente e o tamanho é atualizado via ponteiro qtde.
 *
 * Autor: Breno Farias da Silva
 * Data: 25/04/2025
 */
 
-// Compile and Run: gcc 02.c -o 02 && time ./02
+// Compile and Run: gcc 02.c conjuntos.c -o 02 && time ./02
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
+#include "conjuntos.h"
 
 /**
-* Função auxiliar que troca os valores de dois inteiros.
-*
-* @param a Ponteiro para o primeiro inteiro.
-* @param b Ponteiro para o segundo inteiro.
-*/
-void trocar(int *a, int *b) {
-	int temp = *a;
-	*a = *b;
-	*b = temp;
-}
-
-/**
-* Função recursiva que implementa o algoritmo de ordenação Quick Sort.
-*
-* @param vetor Array de inteiros a ser ordenado.
-* @param inicio Índice inicial da parte do array a ser ordenada.
-* @param fim Índice final da parte do array a ser ordenada.
-*/
-void quickSort(int *vetor, int inicio, int fim) {
-	if (inicio < fim) {
-		int pivo = vetor[fim];
-		int i = inicio - 1;
-
-		for (int j = inicio; j < fim; j++) {
-			if (vetor[j] < pivo) {
-				i++;
-				trocar(&vetor[i], &vetor[j]);
-			}
-		}
-
-		trocar(&vetor[i + 1], &vetor[fim]);
-		int posPivo = i + 1;
-
-		quickSort(vetor, inicio, posPivo - 1);
-		quickSort(vetor, posPivo + 1, fim);
-	}
-}
-
-/**
-* Função que calcula a interseção entre dois arrays inteiros ordenados.
+* Função que calcula a interseção entre dois arrays inteiros com uma tabela hash (conjuntos.c):
+* a tabela é construída com o menor array e consultada com cada elemento do maior, em tempo
+* linear e sem alterar as entradas.
 *
 * @param v1 Primeiro array.
 * @param v2 Segundo array.
 * @param n1 Tamanho do primeiro array.
 * @param n2 Tamanho do segundo array.
 * @param qtde Ponteiro para armazenar a quantidade de elementos na interseção.
-* @return Ponteiro para array dinamicamente alocado com a interseção (sem duplicatas).
+* @return Ponteiro para array dinamicamente alocado com a interseção (sem duplicatas), em ordem não
+* especificada (ver conjuntos.h).
 */
 int* intersecao(int *v1, int *v2, int n1, int n2, int* qtde) {
-	// Validação das entradas
-	if (v1 == NULL || v2 == NULL || qtde == NULL || n1 <= 0 || n2 <= 0) {
-		if (qtde != NULL) *qtde = 0;
-		return NULL;
-	}
-
-	// Ordena os dois arrays
-	quickSort(v1, 0, n1 - 1);
-	quickSort(v2, 0, n2 - 1);
+	return conjunto_intersecao(v1, v2, n1, n2, qtde);
+}
 
-	// Array temporário com tamanho máximo possível
-	int *resultado = (int*)malloc((n1 < n2 ? n1 : n2) * sizeof(int));
-	if (resultado == NULL) {
-		*qtde = 0;
-		return NULL;
+/**
+* Função que mede a interseção de dois arrays aleatórios de n elementos.
+*
+* @param n Tamanho dos arrays.
+*/
+void medirIntersecao(int n) {
+	int *v1 = (int*)malloc(n * sizeof(int));
+	int *v2 = (int*)malloc(n * sizeof(int));
+	if (v1 == NULL || v2 == NULL) {
+		free(v1);
+		free(v2);
+		return;
 	}
 
-	int i = 0, j = 0, k = 0;
-
-	// Percorre ambos os arrays com dois ponteiros
-	while (i < n1 && j < n2) {
-		if (v1[i] < v2[j]) {
-			i++;
-		} else if (v1[i] > v2[j]) {
-			j++;
-		} else {
-			// Evita duplicatas consecutivas
-			if (k == 0 || resultado[k - 1] != v1[i]) {
-				resultado[k++] = v1[i];
-			}
-			i++;
-			j++;
-		}
+	// Valores em [0, 2n), para que boa parte dos elementos seja comum aos dois arrays
+	srand(42);
+	for (int i = 0; i < n; i++) {
+		v1[i] = rand() % (2 * n);
+		v2[i] = rand() % (2 * n);
 	}
 
-	// Atualiza o tamanho da interseção
-	*qtde = k;
+	int qtde = 0;
+	clock_t inicio = clock();
+	int *v3 = intersecao(v1, v2, n, n, &qtde);
+	double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
 
-	// Redimensiona o array para o tamanho final
-	resultado = realloc(resultado, k * sizeof(int));
+	printf("Interseção de dois arrays com %d elementos: %d elementos em %.3f s\n", n, qtde, segundos);
 
-	return resultado;
+	free(v1);
+	free(v2);
+	free(v3);
 }
 
 /**
@@ -126,5 +85,7 @@ int main() {
 
 	free(v3); // Liberação de memória
 
+	medirIntersecao(2000000);
+
 	return 0;
 }
@@ -1,130 +1,69 @@
 /*
-* Descrição: Esta função calcula a união entre dois arrays de inteiros. Ambos os arrays são ordenados
-* com Quick Sort e percorridos simultaneamente com dois ponteiros. O array resultante, contendo a união
-* sem duplicatas, é alocado dinamicamente e seu tamanho é informado por meio de um ponteiro.
+* Descrição: Esta função calcula a união entre dois arrays de inteiros com uma tabela hash, em tempo
+* linear e sem ordenar os arrays: cada elemento entra no resultado na primeira vez em que aparece.
+* O array resultante, contendo a união sem duplicatas, é alocado dinamicamente e seu tamanho é
+* informado por meio de um ponteiro.
 *
 * Autor: Breno Farias da Silva
 * Data: 25/04/2025
 */
 
-// Compile and Run: gcc 03.c -o 03 && time ./03
+// Compile and Run: gcc 03.c conjuntos.c -o 03 && time ./03
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
+#include "conjuntos.h"
 
 /**
- * Função auxiliar que troca o valor de dois inteiros.
- *
- * @param a Ponteiro para o primeiro inteiro.
- * @param b Ponteiro para o segundo inteiro.
- */
- void trocar(int *a, int *b) {
-	int temp = *a;
-	*a = *b;
-	*b = temp;
-}
-
-/**
-* Função que implementa o algoritmo de ordenação Quick Sort.
-*
-* Ordena o array de inteiros no intervalo entre os índices 'inicio' e 'fim'.
-*
-* @param vetor Ponteiro para o array a ser ordenado.
-* @param inicio Índice inicial do intervalo de ordenação.
-* @param fim Índice final do intervalo de ordenação.
-*/
-void quickSort(int *vetor, int inicio, int fim) {
-	if (inicio < fim) {
-		int pivo = vetor[fim];
-		int i = inicio - 1;
-
-		for (int j = inicio; j < fim; j++) {
-			if (vetor[j] < pivo) {
-				i++;
-				trocar(&vetor[i], &vetor[j]);
-			}
-		}
-
-		trocar(&vetor[i + 1], &vetor[fim]);
-		int posPivo = i + 1;
-
-		quickSort(vetor, inicio, posPivo - 1);
-		quickSort(vetor, posPivo + 1, fim);
-	}
-}
-
-/**
-* Função que calcula a união entre dois arrays inteiros ordenados.
+* Função que calcula a união entre dois arrays inteiros com uma tabela hash (conjuntos.c).
 *
-* A função ordena ambos os arrays de entrada, remove duplicatas e retorna um novo array
-* contendo todos os elementos únicos presentes em pelo menos um dos arrays.
+* Cada elemento dos dois arrays é inserido na tabela e copiado para o resultado quando ainda não
+* estava nela, em tempo linear e sem alterar as entradas.
 *
 * @param v1 Primeiro array.
 * @param v2 Segundo array.
 * @param n1 Tamanho do primeiro array.
 * @param n2 Tamanho do segundo array.
 * @param qtde Ponteiro para armazenar a quantidade de elementos da união.
-* @return Ponteiro para array dinamicamente alocado com a união (sem duplicatas).
+* @return Ponteiro para array dinamicamente alocado com a união (sem duplicatas), em ordem não
+* especificada (ver conjuntos.h).
 */
 int* uniao(int *v1, int *v2, int n1, int n2, int* qtde) {
-	// Validação das entradas
-	if (v1 == NULL || v2 == NULL || qtde == NULL || n1 < 0 || n2 < 0) {
-		if (qtde != NULL) *qtde = 0;
-		return NULL;
-	}
-
-	// Ordena os dois arrays
-	quickSort(v1, 0, n1 - 1);
-	quickSort(v2, 0, n2 - 1);
-
-	// Aloca o array resultado com o tamanho máximo possível (n1 + n2)
-	int *resultado = (int*)malloc((n1 + n2) * sizeof(int));
-	if (resultado == NULL) {
-		*qtde = 0;
-		return NULL;
-	}
-
-	int i = 0, j = 0, k = 0;
-
-	// Percorre os dois arrays simultaneamente com dois ponteiros
-	while (i < n1 && j < n2) {
-		if (v1[i] < v2[j]) {
-			if (k == 0 || resultado[k - 1] != v1[i])
-				resultado[k++] = v1[i];
-			i++;
-		} else if (v1[i] > v2[j]) {
-			if (k == 0 || resultado[k - 1] != v2[j])
-				resultado[k++] = v2[j];
-			j++;
-		} else {
-			// Elemento comum aos dois arrays
-			if (k == 0 || resultado[k - 1] != v1[i])
-				resultado[k++] = v1[i];
-			i++;
-			j++;
-		}
-	}
+	return conjunto_uniao(v1, v2, n1, n2, qtde);
+}
 
-	// Copia os elementos restantes de v1
-	while (i < n1) {
-		if (k == 0 || resultado[k - 1] != v1[i])
-			resultado[k++] = v1[i];
-		i++;
+/**
+* Função que mede a união de dois arrays aleatórios de n elementos.
+*
+* @param n Tamanho dos arrays.
+*/
+void medirUniao(int n) {
+	int *v1 = (int*)malloc(n * sizeof(int));
+	int *v2 = (int*)malloc(n * sizeof(int));
+	if (v1 == NULL || v2 == NULL) {
+		free(v1);
+		free(v2);
+		return;
 	}
 
-	// Copia os elementos restantes de v2
-	while (j < n2) {
-		if (k == 0 || resultado[k - 1] != v2[j])
-			resultado[k++] = v2[j];
-		j++;
+	// Valores em [0, 2n), para que boa parte dos elementos se repita
+	srand(42);
+	for (int i = 0; i < n; i++) {
+		v1[i] = rand() % (2 * n);
+		v2[i] = rand() % (2 * n);
 	}
 
-	*qtde = k;
+	int qtde = 0;
+	clock_t inicio = clock();
+	int *v3 = uniao(v1, v2, n, n, &qtde);
+	double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
 
-	// Redimensiona o array para o tamanho final da união
-	resultado = realloc(resultado, k * sizeof(int));
+	printf("União de dois arrays com %d elementos: %d elementos em %.3f s\n", n, qtde, segundos);
 
-	return resultado;
+	free(v1);
+	free(v2);
+	free(v3);
 }
 
 /**
@@ -147,5 +86,7 @@ int main() {
 
 	free(v3); // Liberação da memória alocada
 
+	medirUniao(2000000);
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,338 @@
+/*
+* Descrição: Implementação das operações de conjunto com tabelas hash de endereçamento aberto
+* (sondagem linear). A interseção constrói a tabela com a menor entrada e sonda com a maior; a
+* união insere as duas entradas em uma tabela só; a diferença constrói com a primeira entrada e
+* marca os elementos que aparecem na segunda. Entradas grandes são antes particionadas por radix
+* (contagem e distribuição pelos bits altos do hash), para que a tabela de cada partição caiba na cache.
+*
+* Autor: Breno Farias da Silva
+* Data: 18/10/2026
+*/
+
+#include <stdlib.h> // Funções: malloc, realloc, free
+#include <string.h> // Funções: memset
+#include <stdint.h> // Tipos: uint8_t, uint32_t
+#include <stdbool.h> // Tipo: bool
+#include <limits.h> // Constante: INT_MAX
+#include "conjuntos.h"
+
+// Elementos de cada tabela no caminho particionado: a tabela tem no máximo 32768 posições de
+// 5 bytes (160 KB), que cabem na cache L2
+#define ELEMENTOS_POR_PARTICAO 16384
+// Limite de partições (4096): com mais, a distribuição passa a errar o TLB a cada elemento
+#define MAX_BITS_PARTICAO 12
+
+typedef enum { INTERSECAO, UNIAO, DIFERENCA } Operacao;
+
+// Estado de cada posição da tabela: vazia, com um elemento, ou com um elemento já marcado
+// (já emitido no resultado ou, na diferença, presente na segunda entrada)
+enum { VAZIA = 0, PRESENTE = 1, MARCADA = 2 };
+
+typedef struct {
+	int *chaves;
+	uint8_t *estados;
+	int bits; // a tabela em uso tem 2^bits posições
+} Conjunto;
+
+/**
+* Função que calcula a posição inicial de uma chave (hash multiplicativo de Fibonacci: os bits
+* altos do produto por uma constante ímpar).
+*
+* @param c Conjunto.
+* @param chave Chave a posicionar.
+* @return Posição inicial da chave na tabela.
+*/
+static uint32_t conjunto_posicao(const Conjunto *c, int chave) {
+	return ((uint32_t) chave * 0x9E3779B1u) >> (32 - c->bits);
+}
+
+/**
+* Função que calcula os bits de uma tabela com ao menos o dobro de posições do que elementos
+* (carga de no máximo 50%, que mantém as sondagens curtas).
+*
+* @param n Número máximo de elementos.
+* @return Expoente da potência de 2 de posições.
+*/
+static int conjunto_bits(int n) {
+	int bits = 4;
+	while (bits < 31 && (1L << bits) < 2L * n) bits++;
+	return bits;
+}
+
+/**
+* Função que aloca um conjunto para até n elementos.
+*
+* @param c Conjunto a inicializar.
+* @param n Número máximo de elementos.
+* @return true se a alocação deu certo.
+*/
+static bool conjunto_criar(Conjunto *c, int n) {
+	c->bits = conjunto_bits(n);
+	size_t posicoes = (size_t) 1 << c->bits;
+	c->chaves = (int*) malloc(posicoes * sizeof(int));
+	c->estados = (uint8_t*) malloc(posicoes);
+	return c->chaves != NULL && c->estados != NULL;
+}
+
+/**
+* Função que esvazia o conjunto e ajusta a tabela em uso para n elementos. Só a parte em uso é
+* limpa, então reaproveitar o conjunto em partições pequenas custa pouco.
+*
+* @param c Conjunto.
+* @param n Número máximo de elementos (não pode passar do usado na criação).
+*/
+static void conjunto_preparar(Conjunto *c, int n) {
+	c->bits = conjunto_bits(n);
+	memset(c->estados, VAZIA, (size_t) 1 << c->bits);
+}
+
+static void conjunto_liberar(Conjunto *c) {
+	free(c->chaves);
+	free(c->estados);
+}
+
+/**
+* Função que insere uma chave, caso ainda não esteja no conjunto.
+*
+* @param c Conjunto.
+* @param chave Chave a inserir.
+* @param nova Recebe true se a chave foi inserida agora.
+* @return Posição da chave na tabela.
+*/
+static uint32_t conjunto_inserir(Conjunto *c, int chave, bool *nova) {
+	uint32_t mascara = (1u << c->bits) - 1;
+	uint32_t i = conjunto_posicao(c, chave);
+	while (c->estados[i] != VAZIA) {
+		if (c->chaves[i] == chave) {
+			*nova = false;
+			return i;
+		}
+		i = (i + 1) & mascara;
+	}
+	c->chaves[i] = chave;
+	c->estados[i] = PRESENTE;
+	*nova = true;
+	return i;
+}
+
+/**
+* Função que procura uma chave no conjunto.
+*
+* @param c Conjunto.
+* @param chave Chave procurada.
+* @return Posição da chave na tabela, ou -1 se ela não estiver no conjunto.
+*/
+static int conjunto_buscar(const Conjunto *c, int chave) {
+	uint32_t mascara = (1u << c->bits) - 1;
+	uint32_t i = conjunto_posicao(c, chave);
+	while (c->estados[i] != VAZIA) {
+		if (c->chaves[i] == chave) return (int) i;
+		i = (i + 1) & mascara;
+	}
+	return -1;
+}
+
+/**
+* Função que diz quantos elementos a operação insere na tabela.
+*
+* @param op Operação.
+* @param na Tamanho da primeira entrada.
+* @param nb Tamanho da segunda entrada.
+* @return Número máximo de elementos da tabela.
+*/
+static int elementos_tabela(Operacao op, int na, int nb) {
+	if (op == INTERSECAO) return na < nb ? na : nb;
+	if (op == UNIAO) return na + nb;
+	return na;
+}
+
+/**
+* Função que aplica a operação a duas entradas com um conjunto já alocado, escrevendo o resultado
+* sem duplicatas em saida.
+*
+* @param op Operação.
+* @param a Primeira entrada.
+* @param na Tamanho da primeira entrada.
+* @param b Segunda entrada.
+* @param nb Tamanho da segunda entrada.
+* @param c Conjunto com capacidade para elementos_tabela(op, na, nb) elementos.
+* @param saida Array que recebe o resultado.
+* @return Número de elementos escritos em saida.
+*/
+static int operar(Operacao op, const int *a, int na, const int *b, int nb, Conjunto *c, int *saida) {
+	int k = 0;
+	bool nova;
+	conjunto_preparar(c, elementos_tabela(op, na, nb));
+
+	if (op == INTERSECAO) {
+		// A tabela fica com a menor entrada; a maior só é lida
+		if (nb < na) {
+			const int *t = a; a = b; b = t;
+			int n = na; na = nb; nb = n;
+		}
+		for (int i = 0; i < na; i++) conjunto_inserir(c, a[i], &nova);
+		for (int i = 0; i < nb; i++) {
+			int pos = conjunto_buscar(c, b[i]);
+			if (pos >= 0 && c->estados[pos] == PRESENTE) {
+				c->estados[pos] = MARCADA;
+				saida[k++] = b[i];
+			}
+		}
+	} else if (op == UNIAO) {
+		for (int i = 0; i < na; i++) {
+			conjunto_inserir(c, a[i], &nova);
+			if (nova) saida[k++] = a[i];
+		}
+		for (int i = 0; i < nb; i++) {
+			conjunto_inserir(c, b[i], &nova);
+			if (nova) saida[k++] = b[i];
+		}
+	} else {
+		// A tabela fica com a primeira entrada, que contém o resultado: os elementos de b marcam as
+		// posições a excluir, e a segunda passada por a emite cada elemento não marcado uma vez
+		for (int i = 0; i < na; i++) conjunto_inserir(c, a[i], &nova);
+		for (int i = 0; i < nb; i++) {
+			int pos = conjunto_buscar(c, b[i]);
+			if (pos >= 0) c->estados[pos] = MARCADA;
+		}
+		for (int i = 0; i < na; i++) {
+			int pos = conjunto_buscar(c, a[i]);
+			if (c->estados[pos] == PRESENTE) {
+				c->estados[pos] = MARCADA;
+				saida[k++] = a[i];
+			}
+		}
+	}
+
+	return k;
+}
+
+/**
+* Função que calcula a partição de uma chave pelos bits altos de um hash multiplicativo com outra
+* constante, independente do usado pelas tabelas (senão as chaves de uma partição dividiriam os
+* mesmos bits altos e cairiam na mesma região da tabela).
+*
+* @param chave Chave.
+* @param bits Bits de partição.
+* @return Índice da partição.
+*/
+static uint32_t particao(int chave, int bits) {
+	return ((uint32_t) chave * 0x85EBCA6Bu) >> (32 - bits);
+}
+
+/**
+* Função que distribui v em 2^bits partições (radix de uma passada: contagem, soma de prefixos e
+* distribuição). As chaves iguais sempre caem na mesma partição.
+*
+* @param v Entrada.
+* @param n Tamanho da entrada.
+* @param bits Bits de partição.
+* @param saida Array de n elementos que recebe as partições em sequência.
+* @param inicio Array de 2^bits + 1 posições: a partição p ocupa saida[inicio[p]..inicio[p + 1]).
+*/
+static void particionar(const int *v, int n, int bits, int *saida, int *inicio) {
+	int particoes = 1 << bits;
+	memset(inicio, 0, (particoes + 1) * sizeof(int));
+	for (int i = 0; i < n; i++) inicio[particao(v[i], bits) + 1]++;
+	for (int p = 0; p < particoes; p++) inicio[p + 1] += inicio[p];
+
+	// inicio[p] avança durante a distribuição e termina no início da partição p + 1; o deslocamento
+	// no fim o devolve ao início da partição p
+	for (int i = 0; i < n; i++) saida[inicio[particao(v[i], bits)]++] = v[i];
+	for (int p = particoes; p > 0; p--) inicio[p] = inicio[p - 1];
+	inicio[0] = 0;
+}
+
+/**
+* Função que aplica a operação, direto ou por partições, e aloca o resultado.
+*
+* @param op Operação.
+* @param v1 Primeira entrada.
+* @param v2 Segunda entrada.
+* @param n1 Tamanho da primeira entrada.
+* @param n2 Tamanho da segunda entrada.
+* @param qtde Ponteiro para armazenar o tamanho do resultado.
+* @return Array alocado com o resultado, ou NULL em caso de erro.
+*/
+static int* executar(Operacao op, const int *v1, const int *v2, int n1, int n2, int *qtde) {
+	if (qtde == NULL) return NULL;
+	*qtde = 0;
+	if (n1 < 0 || n2 < 0 || (n1 > 0 && v1 == NULL) || (n2 > 0 && v2 == NULL)) return NULL;
+	if (op == UNIAO && n1 > INT_MAX - n2) return NULL;
+
+	// O resultado nunca tem mais elementos do que a tabela recebe
+	int limite = elementos_tabela(op, n1, n2);
+	int *resultado = (int*) malloc(((size_t) limite + 1) * sizeof(int));
+	if (resultado == NULL) return NULL;
+
+	int bits = 0;
+	while (bits < MAX_BITS_PARTICAO && (limite >> bits) > ELEMENTOS_POR_PARTICAO) bits++;
+
+	Conjunto c = { NULL, NULL, 0 };
+	int k = 0;
+	bool ok;
+
+	if (bits == 0) {
+		ok = conjunto_criar(&c, limite);
+		if (ok) k = operar(op, v1, n1, v2, n2, &c, resultado);
+	} else {
+		int particoes = 1 << bits;
+		int *p1 = (int*) malloc(((size_t) n1 + 1) * sizeof(int));
+		int *p2 = (int*) malloc(((size_t) n2 + 1) * sizeof(int));
+		int *inicio1 = (int*) malloc((particoes + 1) * sizeof(int));
+		int *inicio2 = (int*) malloc((particoes + 1) * sizeof(int));
+		ok = p1 != NULL && p2 != NULL && inicio1 != NULL && inicio2 != NULL;
+
+		if (ok) {
+			particionar(v1, n1, bits, p1, inicio1);
+			particionar(v2, n2, bits, p2, inicio2);
+
+			// Um conjunto só, dimensionado para a maior partição, serve a todas
+			int maior = 0;
+			for (int p = 0; p < particoes; p++) {
+				int e = elementos_tabela(op, inicio1[p + 1] - inicio1[p], inicio2[p + 1] - inicio2[p]);
+				if (e > maior) maior = e;
+			}
+			ok = conjunto_criar(&c, maior);
+			for (int p = 0; ok && p < particoes; p++)
+				k += operar(op, p1 + inicio1[p], inicio1[p + 1] - inicio1[p],
+					p2 + inicio2[p], inicio2[p + 1] - inicio2[p], &c, resultado + k);
+		}
+
+		free(p1);
+		free(p2);
+		free(inicio1);
+		free(inicio2);
+	}
+
+	conjunto_liberar(&c);
+	if (!ok) {
+		free(resultado);
+		return NULL;
+	}
+
+	// Devolve a sobra do array, alocado com o tamanho máximo possível
+	if (k > 0 && k < limite) {
+		int *menor = (int*) realloc(resultado, k * sizeof(int));
+		if (menor != NULL) resultado = menor;
+	}
+
+	*qtde = k;
+	return resultado;
+}
+
+int* conjunto_intersecao(const int *v1, const int *v2, int n1, int n2, int *qtde) {
+	return executar(INTERSECAO, v1, v2, n1, n2, qtde);
+}
+
+int* conjunto_uniao(const int *v1, const int *v2, int n1, int n2, int *qtde) {
+	return executar(UNIAO, v1, v2, n1, n2, qtde);
+}
+
+int* conjunto_diferenca(const int *v1, const int *v2, int n1, int n2, int *qtde) {
+	return executar(DIFERENCA, v1, v2, n1, n2, qtde);
+}
+
+int* conjunto_distintos(const int *v, int n, int *qtde) {
+	return executar(UNIAO, v, NULL, n, 0, qtde);
+}
@@ -0,0 +1,25 @@
+/*
+* Descrição: Operações de conjunto (interseção, união, diferença e distintos) sobre arrays de
+* inteiros com tabelas hash, em tempo linear e sem ordenar as entradas. Quando a tabela não cabe
+* na cache, as entradas são particionadas pelos bits do hash (radix) e cada partição é
+* processada com uma tabela pequena, que fica na cache.
+*
+* Autor: Breno Farias da Silva
+* Data: 18/10/2026
+*/
+
+#ifndef _CONJUNTOS_H_
+#define _CONJUNTOS_H_
+
+// Todas as funções devolvem um array alocado dinamicamente, sem duplicatas, que o chamador deve
+// liberar com free, e guardam em *qtde o número de elementos (0 para resultado vazio). As entradas
+// não são alteradas. Devolvem NULL (com *qtde = 0) se os parâmetros forem inválidos ou faltar memória.
+// A ordem do resultado não é a ordenada: é a ordem das entradas quando a tabela cabe na cache e,
+// nas entradas grandes, a ordem das entradas dentro de cada partição.
+
+int* conjunto_intersecao(const int *v1, const int *v2, int n1, int n2, int *qtde);
+int* conjunto_uniao(const int *v1, const int *v2, int n1, int n2, int *qtde);
+int* conjunto_diferenca(const int *v1, const int *v2, int n1, int n2, int *qtde); // elementos de v1 fora de v2
+int* conjunto_distintos(const int *v, int n, int *qtde);
+
+#endif
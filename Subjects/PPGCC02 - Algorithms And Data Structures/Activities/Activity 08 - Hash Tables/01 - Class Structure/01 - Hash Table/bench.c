@@ -0,0 +1,343 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include "hash.h"
+#include "hash_concorrente.h"
+
+// Compara as sondagens linear, quadrática e dupla (modos ponteiro e inline) com os modos SIMD,
+// Robin Hood e cuckoo em uma carga de trabalho dominada por buscas, com todas as tabelas carregadas
+// a 87%, e mostra o deslocamento máximo de cada uma (o pior caso das buscas). As buscas com acerto
+// também são medidas em lote (hash_buscar_lote), com prefetch das origens. Depois mede o custo de
+// pior caso das buscas a 90% de carga (sondagens inline contra o cuckoo).
+// Em seguida mede a latência das inserções de uma tabela que cresce sozinha, com
+// redimensionamento de uma vez e com redimensionamento incremental, e por fim a vazão da
+// tabela concorrente com 1 partição (uma trava global) e com 64 partições, de 1 a 8 threads,
+// e o custo de reconstruir uma tabela inline contra o de abrir o seu arquivo mapeado.
+// Uso: ./bench [log2_posicoes] [semente]
+
+#define CARGA 0.87
+
+typedef struct {
+	const char *nome;
+	HashModo modo;
+	bool (*inserir)(Hash *h, TipoElemento *elemento);
+	bool (*buscar)(Hash *h, int chave, TipoElemento **elemento);
+} Estrategia;
+
+static const Estrategia estrategias[] = {
+	{ "linear",           HASH_PONTEIRO, hash_inserir_linear,     hash_buscar_linear },
+	{ "quadratica",       HASH_PONTEIRO, hash_inserir_quadratica, hash_buscar_quadratica },
+	{ "duplo",            HASH_PONTEIRO, hash_inserir_duplo,      hash_buscar_duplo },
+	{ "linear inline",    HASH_INLINE,   hash_inserir_linear,     hash_buscar_linear },
+	{ "quadratica inline",HASH_INLINE,   hash_inserir_quadratica, hash_buscar_quadratica },
+	{ "duplo inline",     HASH_INLINE,   hash_inserir_duplo,      hash_buscar_duplo },
+	{ "simd",             HASH_SIMD,     hash_inserir_linear,     hash_buscar_linear },
+	{ "robin hood",       HASH_ROBIN_HOOD, hash_inserir_linear,   hash_buscar_linear },
+	{ "cuckoo",           HASH_CUCKOO,   hash_inserir_linear,     hash_buscar_linear },
+};
+
+#define NUM_ESTRATEGIAS (int) (sizeof(estrategias) / sizeof(estrategias[0]))
+
+static uint64_t estado; // gerador splitmix64, para execuções reproduzíveis
+
+static uint64_t aleatorio(void) {
+	uint64_t z = (estado += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static uint64_t agora_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+// Menor primo maior ou igual a n: tamanho usado pelas sondagens quadrática e dupla
+static int primo_a_partir_de(int n) {
+	for (;; n++) {
+		bool primo = n > 1;
+		for (int d = 2; (long) d * d <= n && primo; d++)
+			if (n % d == 0) primo = false;
+		if (primo) return n;
+	}
+}
+
+static int comparar_u64(const void *a, const void *b) {
+	uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+	return (x > y) - (x < y);
+}
+
+// Insere as chaves em uma tabela inline que dobra de tamanho ao passar de 50% de carga e
+// imprime as latências de inserção (p50, p99,9 e máxima)
+static void crescimento(const int chaves[], int n, bool incremental) {
+	Hash *h = hash_criar_modo(1024, HASH_INLINE);
+	uint64_t *latencias = (uint64_t*) malloc(sizeof(uint64_t) * n);
+	if (h == NULL || latencias == NULL) {
+		printf("Falha ao alocar memória\n");
+		exit(1);
+	}
+
+	TipoElemento el;
+	for (int i = 0; i < n; i++) {
+		el.chave = chaves[i];
+		el.dado = i;
+		uint64_t inicio = agora_ns();
+		if (hash_fator_carga(h) > 0.5 && !hash_redimensionando(h)) {
+			int novo = primo_a_partir_de(hash_tamanho(h) * 4);
+			if (incremental) hash_redimensionar_incremental(h, novo);
+			else hash_redimensionar(h, novo);
+		}
+		hash_inserir_linear(h, &el);
+		latencias[i] = agora_ns() - inicio;
+	}
+
+	qsort(latencias, n, sizeof(uint64_t), comparar_u64);
+	printf("%-18s %10llu %12llu %12.1f\n", incremental ? "incremental" : "de uma vez",
+		(unsigned long long) latencias[n / 2], (unsigned long long) latencias[(int) (n * 0.999)],
+		latencias[n - 1] / 1e6);
+
+	free(latencias);
+	hash_destruir(&h);
+}
+
+// Percentil p (entre 0 e 1) de n latências, que são ordenadas
+static uint64_t percentil(uint64_t latencias[], int n, double p) {
+	qsort(latencias, n, sizeof(uint64_t), comparar_u64);
+	return latencias[(int) ((n - 1) * p)];
+}
+
+// Carrega a tabela a 90% e cronometra cada busca (com e sem acerto) isoladamente, imprimindo
+// o deslocamento máximo, a mediana, o percentil 99,9 e a pior latência
+static void pior_caso(const Estrategia *est, int tamanho, const int presentes[], const int ausentes[], uint64_t latencias[]) {
+	Hash *h = hash_criar_modo(tamanho, est->modo);
+	if (h == NULL) {
+		printf("Falha ao criar hash\n");
+		exit(1);
+	}
+
+	TipoElemento el, *res;
+	int n = 0;
+	while (hash_fator_carga(h) < 0.9f) {
+		el.chave = presentes[n];
+		el.dado = n;
+		if (!est->inserir(h, &el)) break;
+		n++;
+	}
+
+	printf("%-18s %8d", est->nome, hash_deslocamento_maximo(h));
+	for (int falha = 0; falha <= 1; falha++) {
+		const int *chaves = falha ? ausentes : presentes;
+		for (int i = 0; i < n; i++) {
+			uint64_t inicio = agora_ns();
+			est->buscar(h, chaves[i], &res);
+			latencias[i] = agora_ns() - inicio;
+		}
+		uint64_t mediana = percentil(latencias, n, 0.5);
+		printf(" %8llu %10llu %10llu", (unsigned long long) mediana,
+			(unsigned long long) percentil(latencias, n, 0.999), (unsigned long long) latencias[n - 1]);
+	}
+	printf("\n");
+	hash_destruir(&h);
+}
+
+typedef struct {
+	HashConcorrente *hc;
+	const int *chaves;
+	int inicio, fim;
+} Trabalho;
+
+// Cada thread insere a sua faixa de chaves e depois busca cada uma delas quatro vezes
+static void* trabalhador(void *arg) {
+	Trabalho *t = (Trabalho*) arg;
+	TipoElemento el;
+	for (int i = t->inicio; i < t->fim; i++) {
+		el.chave = t->chaves[i];
+		el.dado = i;
+		hash_concorrente_inserir(t->hc, &el);
+	}
+	for (int r = 0; r < 4; r++)
+		for (int i = t->inicio; i < t->fim; i++)
+			hash_concorrente_buscar(t->hc, t->chaves[i], &el);
+	return NULL;
+}
+
+// Imprime a vazão (milhões de operações por segundo) de uma tabela inline concorrente
+static void concorrencia(const int chaves[], int n, int particoes) {
+	printf("%-10d", particoes);
+	for (int threads = 1; threads <= 8; threads *= 2) {
+		HashConcorrente *hc = hash_concorrente_criar(particoes, 1024, HASH_INLINE);
+		pthread_t ids[8];
+		Trabalho trabalhos[8];
+		if (hc == NULL) {
+			printf("Falha ao criar hash\n");
+			exit(1);
+		}
+
+		uint64_t inicio = agora_ns();
+		for (int t = 0; t < threads; t++) {
+			trabalhos[t] = (Trabalho) { hc, chaves, (int) ((long) n * t / threads), (int) ((long) n * (t + 1) / threads) };
+			pthread_create(&ids[t], NULL, trabalhador, &trabalhos[t]);
+		}
+		for (int t = 0; t < threads; t++)
+			pthread_join(ids[t], NULL);
+		uint64_t total = agora_ns() - inicio;
+
+		printf(" %10.2f", 5.0 * n / (total / 1e3));
+		hash_concorrente_destruir(&hc);
+	}
+	printf("\n");
+}
+
+// Compara a inicialização de uma tabela inline reconstruída a partir dos elementos com a
+// abertura do arquivo salvo (mmap, sem desserialização), e as buscas nas duas
+static void persistencia(const TipoElemento elementos[], const int presentes[], int n, int tamanho) {
+	const char *caminho = "bench_hash.dat";
+	TipoElemento *res;
+
+	uint64_t inicio = agora_ns();
+	Hash *h = hash_criar_modo(tamanho, HASH_INLINE);
+	for (int i = 0; h != NULL && i < n; i++)
+		hash_inserir_linear(h, (TipoElemento*) &elementos[i]);
+	uint64_t reconstruir = agora_ns() - inicio;
+
+	inicio = agora_ns();
+	bool salvo = hash_salvar(h, caminho);
+	uint64_t salvar = agora_ns() - inicio;
+
+	inicio = agora_ns();
+	Hash *m = salvo ? hash_abrir_mapeado(caminho) : NULL;
+	uint64_t abrir = agora_ns() - inicio;
+	if (m == NULL) {
+		printf("Falha ao salvar ou abrir %s\n", caminho);
+		hash_destruir(&h);
+		return;
+	}
+
+	Hash *tabelas[] = { h, m };
+	uint64_t buscas[2];
+	long encontrados = 0;
+	for (int t = 0; t < 2; t++) {
+		inicio = agora_ns();
+		for (int i = n - 1; i >= 0; i--)
+			encontrados += hash_buscar_linear(tabelas[t], presentes[i], &res);
+		buscas[t] = agora_ns() - inicio;
+	}
+	if (encontrados != 2L * n) printf("Aviso: %ld de %d chaves encontradas\n", encontrados, 2 * n);
+
+	printf("%-18s %12.2f %12s %12.1f\n", "reconstruir", reconstruir / 1e6, "-", (double) buscas[0] / n);
+	printf("%-18s %12.2f %12.2f %12.1f\n", "abrir mapeado", abrir / 1e6, salvar / 1e6, (double) buscas[1] / n);
+	hash_destruir(&h);
+	hash_destruir(&m);
+	remove(caminho);
+}
+
+int main(int argc, char *argv[]) {
+	int bits = argc > 1 ? atoi(argv[1]) : 20;
+	estado = argc > 2 ? strtoull(argv[2], NULL, 10) : 42;
+	if (bits < 4 || bits > 28) {
+		printf("Uso: %s [log2_posicoes (4 a 28)] [semente]\n", argv[0]);
+		return 1;
+	}
+
+	// O modo SIMD aloca uma potência de 2 de posições; as demais tabelas usam o primo seguinte,
+	// de forma que todas tenham praticamente o mesmo número de posições e a mesma carga
+	int posicoes = 1 << bits;
+	int n = (int) (posicoes * CARGA);
+	int tamanho = primo_a_partir_de(posicoes);
+
+	// Chaves presentes são pares e as ausentes são ímpares, todas não negativas. Há chaves para
+	// todas as posições, pois a medição de pior caso carrega as tabelas a 90%.
+	int *presentes = (int*) malloc(sizeof(int) * tamanho);
+	int *ausentes = (int*) malloc(sizeof(int) * tamanho);
+	TipoElemento *elementos = (TipoElemento*) malloc(sizeof(TipoElemento) * n);
+	TipoElemento **resultados = (TipoElemento**) malloc(sizeof(TipoElemento*) * n);
+	uint64_t *latencias = (uint64_t*) malloc(sizeof(uint64_t) * tamanho);
+	if (!presentes || !ausentes || !elementos || !resultados || !latencias) {
+		printf("Falha ao alocar memória\n");
+		return 1;
+	}
+	for (int i = 0; i < tamanho; i++) {
+		presentes[i] = (int) (aleatorio() & 0x3FFFFFFF) * 2;
+		ausentes[i] = (int) (aleatorio() & 0x3FFFFFFF) * 2 + 1;
+	}
+	for (int i = 0; i < n; i++) {
+		elementos[i].chave = presentes[i];
+		elementos[i].dado = i;
+	}
+
+	printf("%d elementos em tabelas de %d posições (carga %.2f)\n\n", n, posicoes, CARGA);
+	printf("%-18s %10s %12s %12s %12s %8s %12s %10s\n", "estrategia", "insercao", "busca_acerto", "busca_falha", "busca_lote", "carga", "colisoes", "desl_max");
+	printf("%-18s %10s %12s %12s %12s %8s %12s %10s\n", "", "(ns/op)", "(ns/op)", "(ns/op)", "(ns/op)", "", "", "");
+
+	for (int e = 0; e < NUM_ESTRATEGIAS; e++) {
+		const Estrategia *est = &estrategias[e];
+		// O modo SIMD recebe a quantidade de elementos e dimensiona os próprios grupos
+		Hash *h = hash_criar_modo(est->modo == HASH_SIMD ? n : tamanho, est->modo);
+		if (h == NULL) {
+			printf("Falha ao criar hash\n");
+			return 1;
+		}
+
+		uint64_t inicio = agora_ns();
+		for (int i = 0; i < n; i++)
+			est->inserir(h, &elementos[i]);
+		uint64_t insercao = agora_ns() - inicio;
+
+		TipoElemento *res;
+		long encontrados = 0;
+		inicio = agora_ns();
+		for (int i = n - 1; i >= 0; i--)
+			encontrados += est->buscar(h, presentes[i], &res);
+		uint64_t acerto = agora_ns() - inicio;
+
+		inicio = agora_ns();
+		for (int i = 0; i < n; i++)
+			encontrados += est->buscar(h, ausentes[i], &res);
+		uint64_t falha = agora_ns() - inicio;
+
+		inicio = agora_ns();
+		int no_lote = hash_buscar_lote(h, presentes, n, resultados);
+		uint64_t lote = agora_ns() - inicio;
+
+		if (encontrados < hash_tamanho(h) || no_lote < hash_tamanho(h))
+			printf("Aviso: %s encontrou %ld de %d chaves\n", est->nome, encontrados, hash_tamanho(h));
+
+		printf("%-18s %10.1f %12.1f %12.1f %12.1f %8.2f %12d %10d\n", est->nome,
+			(double) insercao / n, (double) acerto / n, (double) falha / n, (double) lote / n,
+			hash_fator_carga(h), hash_colisoes(h), hash_deslocamento_maximo(h));
+		hash_destruir(&h);
+	}
+
+	printf("\nPior caso das buscas com carga de 90%% (latências em ns, cada busca cronometrada isoladamente)\n\n");
+	printf("%-18s %8s %8s %10s %10s %8s %10s %10s\n", "estrategia", "desl_max",
+		"acerto50", "acerto99,9", "acerto_max", "falha50", "falha99,9", "falha_max");
+	for (int e = 0; e < NUM_ESTRATEGIAS; e++) {
+		const Estrategia *est = &estrategias[e];
+		if (est->modo == HASH_INLINE || est->modo == HASH_CUCKOO)
+			pior_caso(est, tamanho, presentes, ausentes, latencias);
+	}
+
+	printf("\nCrescimento de 1024 posições até %d elementos (inline, sondagem linear)\n\n", n);
+	printf("%-18s %10s %12s %12s\n", "redimensionamento", "p50 (ns)", "p99,9 (ns)", "max (ms)");
+	crescimento(presentes, n, false);
+	crescimento(presentes, n, true);
+
+	printf("\nTabela concorrente: %d inserções e %d buscas (milhões de operações/s)\n\n", n, 4 * n);
+	printf("%-10s %10s %10s %10s %10s\n", "particoes", "1 thread", "2 threads", "4 threads", "8 threads");
+	concorrencia(presentes, n, 1);
+	concorrencia(presentes, n, 64);
+
+	printf("\nInicialização de uma tabela inline com %d elementos (a busca inclui as faltas de página do mapeamento)\n\n", n);
+	printf("%-18s %12s %12s %12s\n", "", "pronta (ms)", "salvar (ms)", "busca (ns/op)");
+	persistencia(elementos, presentes, n, tamanho);
+
+	free(presentes);
+	free(ausentes);
+	free(elementos);
+	free(resultados);
+	free(latencias);
+	return 0;
+}
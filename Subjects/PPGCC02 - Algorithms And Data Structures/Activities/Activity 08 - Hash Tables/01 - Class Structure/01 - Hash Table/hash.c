@@ -1,17 +1,114 @@
 #include "hash.h"
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #define TAM_INICIAL 100000
 
+// Estados do byte de controle de cada posição no modo inline
+#define CONTROLE_VAZIO    0
+#define CONTROLE_OCUPADO  1
+#define CONTROLE_REMOVIDO 2 // posição liberada que não interrompe as sequências de sondagem
+
+// Modo SIMD: posições agrupadas em blocos de 16; posições ocupadas guardam os 7 bits H2 do hash,
+// as livres têm o bit mais alto ligado
+#define GRUPO          16
+#define SIMD_VAZIO     0x80
+#define SIMD_REMOVIDO  0xFE
+#define SIMD_CARGA_NUM 7 // carga máxima de 7/8 (87,5%) das posições
+#define SIMD_CARGA_DEN 8
+
+// Modo Robin Hood: o byte de controle guarda a distância da posição de origem mais um (0 é vazio).
+// Distâncias a partir de RH_SATURADO - 1 ficam saturadas e são recalculadas pelo hash quando preciso.
+#define RH_SATURADO 254
+#define RH_REMOVIDO 255 // só aparece na tabela antiga durante a migração
+
+// Modo cuckoo: baldes de 4 posições contíguas (32 bytes, dentro de uma linha de cache) e um
+// estoque de poucas posições no fim do vetor para os elementos que nenhum caminho de despejo acomoda
+#define CUCKOO_VIAS   4
+#define CUCKOO_ESTOQUE 4
+#define CUCKOO_BFS    128 // baldes visitados, no máximo, pela busca em largura de um caminho de despejo
+
+#define TABULACAO_TABELAS 4 // um int tem 4 bytes
+
+#define LINHA_CACHE 64
+
+// Buscas em lote: quantidade de chaves cujas origens são calculadas e trazidas para a cache juntas
+#define LOTE_BLOCO 16
+
+// Posições da tabela antiga migradas a cada operação durante o redimensionamento incremental
+#define MIGRACAO_PASSO 64
+
+// Formato de arquivo da tabela inline: cabeçalho, registros (alinhados à linha de cache), bytes de
+// controle e, se a função for a tabulação, as tabelas aleatórias. Os vetores são gravados como
+// estão na memória, então o arquivo só é lido em máquinas com a mesma ordem de bytes.
+#define ARQUIVO_MAGICA "HASHINL"
+#define ARQUIVO_VERSAO 1
+#define ARQUIVO_ORDEM  0x01020304u
+
+// Marca de remoção do modo ponteiro: endereço que nunca é um elemento do chamador
+static TipoElemento sentinela_removido;
+#define ITEM_REMOVIDO (&sentinela_removido)
+
 /**************************************
 * DADOS
 **************************************/
 
+// Estratégias de sondagem das inserções, buscas e remoções
+typedef enum { SONDAGEM_LINEAR, SONDAGEM_QUADRATICA, SONDAGEM_DUPLA } Sondagem;
+
 struct hash{
   int qtde, tamanho;
-  TipoElemento **itens;
+  TipoElemento **itens;      // modo ponteiro
+  TipoElemento *registros;   // modos inline, SIMD e Robin Hood: registros contíguos
+  unsigned char *controle;   // modos inline, SIMD e Robin Hood: estado de cada posição
+  TipoElemento removido;     // modos inline, SIMD e Robin Hood: cópia devolvida pelas remoções
+  int limite;                // modo SIMD: quantidade máxima de elementos
+  int estoque;               // modo cuckoo: elementos guardados no estoque
+  int removidos;             // posições com marca de remoção (descartadas no redimensionamento)
   int colisoes;
+  HashModo modo;
+  Sondagem sondagem;         // sondagem da última inserção, usada para reinserir ao redimensionar
+  Hash *antiga;              // tabela anterior enquanto o redimensionamento incremental não termina
+  int migrados;              // posições da tabela antiga já migradas (sempre as primeiras)
+  bool politica_ativa;       // redimensiona automaticamente segundo a política de carga
+  HashPolitica politica;
+  int tamanho_minimo;        // posições na criação: a política nunca encolhe abaixo disso
+  HashFuncao funcao;
+  uint64_t semente;          // sorteada por tabela; multiplicador e deslocamento da multiplicação-deslocamento
+  uint64_t semente2;
+  uint64_t (*tabulacao)[256]; // tabelas aleatórias da tabulação (só alocadas quando ela é escolhida)
+  void *mapa;                // arquivo mapeado por hash_abrir_mapeado (tabela somente leitura) ou NULL
+  size_t mapa_bytes;
 };
 
+typedef struct {
+  char magica[8];
+  uint32_t versao;
+  uint32_t ordem;            // ARQUIVO_ORDEM na ordem de bytes de quem gravou
+  uint32_t modo;
+  uint32_t funcao;           // HashFuncao
+  uint32_t sondagem;         // sondagem da última inserção: as buscas precisam usar a mesma
+  int32_t tamanho;
+  int32_t qtde;
+  int32_t removidos;
+  uint64_t semente;
+  uint64_t semente2;
+  uint64_t desloc_registros;
+  uint64_t desloc_controle;
+  uint64_t desloc_tabulacao; // 0 se a função não for a tabulação
+  uint64_t bytes;            // tamanho total do arquivo
+} CabecalhoArquivo;
+
 
 /**************************************
 * FUNÇÕES AUXILIARES
@@ -21,83 +118,977 @@ bool hash_ehValida(Hash* h){
 	return (h != NULL? true: false);
 }
 
+// Gerador splitmix64: expande uma semente em valores pseudoaleatórios independentes
+static uint64_t splitmix64(uint64_t *estado){
+	uint64_t z = (*estado += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// Semente diferente para cada tabela criada, mesmo dentro do mesmo segundo (o contador é
+// atômico porque partições de uma tabela concorrente podem ser criadas em threads diferentes)
+static uint64_t hash_semente_aleatoria(void){
+	static uint64_t contador = 0;
+	uint64_t n = __atomic_add_fetch(&contador, 1, __ATOMIC_RELAXED);
+	uint64_t estado = (uint64_t) time(NULL) ^ ((uint64_t) (uintptr_t) &contador << 16) ^ (n << 40);
+	return splitmix64(&estado);
+}
+
+// Multiplicação de 128 bits dobrada em 64 (a operação básica do wyhash)
+static uint64_t hash_mum(uint64_t a, uint64_t b){
+	__uint128_t r = (__uint128_t) a * b;
+	return (uint64_t) r ^ (uint64_t) (r >> 64);
+}
+
+// Hash de 64 bits da chave. Na multiplicação-deslocamento só os 32 bits altos são bons;
+// nas outras funções as duas metades são independentes.
+static uint64_t hash_calcular(Hash *h, int chave){
+	uint64_t x = (uint32_t) chave;
+	switch (h->funcao) {
+		case HASH_FUNCAO_MULT_SHIFT:
+			return (h->semente | 1) * x + h->semente2;
+		case HASH_FUNCAO_MISTURADOR: {
+			// Caminho do wyhash para entradas de 4 bytes
+			uint64_t y = x << 32 | x;
+			__uint128_t m = (__uint128_t) (y ^ 0xe7037ed1a0b428dbULL) * (y ^ h->semente);
+			return hash_mum((uint64_t) m ^ 0xa0761d6478bd642fULL ^ 4, (uint64_t) (m >> 64) ^ 0xe7037ed1a0b428dbULL);
+		}
+		case HASH_FUNCAO_TABULACAO: {
+			uint64_t r = 0;
+			for (int i = 0; i < TABULACAO_TABELAS; i++)
+				r ^= h->tabulacao[i][(x >> (8 * i)) & 0xFF];
+			return r;
+		}
+		default:
+			return x;
+	}
+}
+
+// Redução de Lemire: leva x de 32 bits ao intervalo [0, n) sem divisão
+static int hash_reduzir(uint32_t x, int n){
+	return (int) (((uint64_t) x * (uint32_t) n) >> 32);
+}
+
 int hash_funcao(Hash* h, int chave){
-	return chave % h->tamanho;
+	if (h->funcao == HASH_FUNCAO_DIVISAO) return chave % h->tamanho;
+	return hash_reduzir((uint32_t) (hash_calcular(h, chave) >> 32), h->tamanho);
+}
+
+// Posição da tentativa i+1 a partir da posição pos da tentativa i, sem divisão: os deslocamentos
+// i, i*i e i*h2 crescem de 1, 2i+1 e h2 a cada tentativa
+static int hash_sondar(Hash *h, int pos, int h2, int i, Sondagem sondagem){
+	switch (sondagem) {
+		case SONDAGEM_LINEAR:     pos += 1; break;
+		case SONDAGEM_QUADRATICA: pos += 2*i + 1; break;
+		default:                  pos += h2; break;
+	}
+	while (pos >= h->tamanho) pos -= h->tamanho;
+	return pos;
+}
+
+// Elemento armazenado na posição ou NULL, em qualquer modo
+static TipoElemento* hash_posicao(Hash *h, int pos){
+	if (h->modo == HASH_INLINE)
+		return h->controle[pos] == CONTROLE_OCUPADO ? &h->registros[pos] : NULL;
+	if (h->modo == HASH_SIMD)
+		return (h->controle[pos] & 0x80) ? NULL : &h->registros[pos];
+	if (h->modo == HASH_ROBIN_HOOD)
+		return (h->controle[pos] == 0 || h->controle[pos] == RH_REMOVIDO) ? NULL : &h->registros[pos];
+	if (h->modo == HASH_CUCKOO)
+		return h->controle[pos] == CONTROLE_VAZIO ? NULL : &h->registros[pos];
+	return h->itens[pos] == ITEM_REMOVIDO ? NULL : h->itens[pos];
+}
+
+// Posição que nunca foi ocupada: é onde as sequências de sondagem terminam
+static bool hash_posicao_virgem(Hash *h, int pos){
+	if (h->modo == HASH_INLINE || h->modo == HASH_ROBIN_HOOD || h->modo == HASH_CUCKOO) return h->controle[pos] == CONTROLE_VAZIO;
+	if (h->modo == HASH_SIMD) return h->controle[pos] == SIMD_VAZIO;
+	return h->itens[pos] == NULL;
+}
+
+// Grava o elemento na posição (cópia nos modos inline e SIMD, ponteiro no modo ponteiro)
+static void hash_gravar(Hash *h, int pos, TipoElemento *elemento){
+	if (!hash_posicao_virgem(h, pos)) h->removidos--; // reaproveita uma marca de remoção
+	if (h->modo == HASH_INLINE) {
+		h->registros[pos] = *elemento;
+		h->controle[pos] = CONTROLE_OCUPADO;
+	} else {
+		h->itens[pos] = elemento;
+	}
+	h->qtde++;
+}
+
+// Insere na primeira posição livre da sondagem (modos ponteiro e inline)
+static bool sondagem_inserir(Hash *h, TipoElemento *elemento, Sondagem sondagem){
+	int newPos = hash_funcao(h, elemento->chave);
+	int h2 = sondagem == SONDAGEM_DUPLA ? hash_funcao_secundaria(h, elemento->chave) : 0;
+
+	for (int i = 0; i < h->tamanho; i++) {
+		if (hash_posicao(h, newPos) == NULL) {
+			hash_gravar(h, newPos, elemento);
+			return true;
+		} else {
+			h->colisoes++; // Incrementa o contador de colisões
+		}
+		newPos = hash_sondar(h, newPos, h2, i, sondagem);
+	}
+
+	return false; // tabela cheia
+}
+
+// Posição da chave ou -1, sondando a partir da origem newPos; a sondagem só termina em uma
+// posição nunca ocupada (modos ponteiro e inline)
+static int sondagem_localizar(Hash *h, int chave, int newPos, Sondagem sondagem){
+	int h2 = sondagem == SONDAGEM_DUPLA ? hash_funcao_secundaria(h, chave) : 0;
+
+	for (int i = 0; i < h->tamanho; i++) {
+		if (hash_posicao_virgem(h, newPos)) return -1;
+		TipoElemento *el = hash_posicao(h, newPos);
+		if (el != NULL && el->chave == chave) return newPos;
+		newPos = hash_sondar(h, newPos, h2, i, sondagem);
+	}
+	return -1;
+}
+
+// Hash de 64 bits da chave (finalizador do MurmurHash3): H1 escolhe o grupo inicial e H2 é a impressão de 7 bits
+static uint64_t simd_misturar(int chave){
+	uint64_t x = (uint32_t) chave;
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return x;
+}
+
+// Máscara com um bit para cada byte de controle do grupo igual a valor
+static unsigned grupo_comparar(const unsigned char *grupo, unsigned char valor){
+#ifdef __SSE2__
+	__m128i bytes = _mm_loadu_si128((const __m128i *) grupo);
+	return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8((char) valor)));
+#else
+	unsigned mascara = 0;
+	for (int i = 0; i < GRUPO; i++)
+		if (grupo[i] == valor) mascara |= 1u << i;
+	return mascara;
+#endif
+}
+
+// Máscara das posições livres (vazias ou removidas) do grupo: as que têm o bit mais alto ligado
+static unsigned grupo_livres(const unsigned char *grupo){
+#ifdef __SSE2__
+	return (unsigned) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) grupo));
+#else
+	unsigned mascara = 0;
+	for (int i = 0; i < GRUPO; i++)
+		if (grupo[i] & 0x80) mascara |= 1u << i;
+	return mascara;
+#endif
+}
+
+// Aloca grupos suficientes para guardar capacidade elementos com carga de até 7/8.
+// A quantidade de grupos é potência de 2, para que a sondagem triangular visite todos eles.
+static bool simd_alocar(Hash *h, int capacidade){
+	long necessarias = ((long) capacidade * SIMD_CARGA_DEN + SIMD_CARGA_NUM - 1) / SIMD_CARGA_NUM;
+	long grupos = 1;
+	while (grupos * GRUPO < necessarias) grupos <<= 1;
+	if (grupos * GRUPO > INT32_MAX) return false;
+
+	int posicoes = (int) (grupos * GRUPO);
+	TipoElemento *registros = (TipoElemento*) malloc(sizeof(TipoElemento)*posicoes);
+	unsigned char *controle = (unsigned char*) malloc(posicoes);
+	if (registros == NULL || controle == NULL) {
+		free(registros);
+		free(controle);
+		return false;
+	}
+	memset(controle, SIMD_VAZIO, posicoes);
+
+	h->registros = registros;
+	h->controle = controle;
+	h->tamanho = posicoes;
+	h->limite = capacidade;
+	return true;
+}
+
+static bool simd_inserir(Hash *h, TipoElemento *elemento){
+	if (h->qtde >= h->limite) return false;
+
+	uint64_t x = simd_misturar(elemento->chave);
+	int mascara_grupos = h->tamanho / GRUPO - 1;
+	int g = (int) (x >> 7) & mascara_grupos;
+
+	for (int passo = 0; passo <= mascara_grupos; passo++) {
+		unsigned livres = grupo_livres(h->controle + g * GRUPO);
+		if (livres) {
+			int pos = g * GRUPO + __builtin_ctz(livres);
+			if (h->controle[pos] == SIMD_REMOVIDO) h->removidos--;
+			h->registros[pos] = *elemento;
+			h->controle[pos] = (unsigned char) (x & 0x7F);
+			h->qtde++;
+			return true;
+		}
+		h->colisoes++; // cada grupo cheio conta como colisão
+		g = (g + passo + 1) & mascara_grupos; // sondagem triangular entre grupos
+	}
+	return false;
+}
+
+// Posição da chave de hash x ou -1. Cada passo compara a impressão H2 com os 16 bytes de controle
+// do grupo de uma só vez; a busca termina no primeiro grupo que tem alguma posição vazia.
+static int simd_localizar(Hash *h, int chave, uint64_t x){
+	unsigned char h2 = (unsigned char) (x & 0x7F);
+	int mascara_grupos = h->tamanho / GRUPO - 1;
+	int g = (int) (x >> 7) & mascara_grupos;
+
+	for (int passo = 0; passo <= mascara_grupos; passo++) {
+		const unsigned char *grupo = h->controle + g * GRUPO;
+		for (unsigned candidatos = grupo_comparar(grupo, h2); candidatos; candidatos &= candidatos - 1) {
+			int pos = g * GRUPO + __builtin_ctz(candidatos);
+			if (h->registros[pos].chave == chave) return pos;
+		}
+		if (grupo_comparar(grupo, SIMD_VAZIO)) return -1;
+		g = (g + passo + 1) & mascara_grupos;
+	}
+	return -1;
+}
+
+// Byte de controle do modo Robin Hood para um elemento a dist posições da origem
+static unsigned char rh_controle(int dist){
+	return (unsigned char) (dist + 1 < RH_SATURADO ? dist + 1 : RH_SATURADO);
+}
+
+// Distância da posição ocupada pos até a origem do seu elemento (modo Robin Hood)
+static int rh_distancia(Hash *h, int pos){
+	if (h->controle[pos] < RH_SATURADO) return h->controle[pos] - 1;
+	int origem = hash_funcao(h, h->registros[pos].chave);
+	return pos >= origem ? pos - origem : pos + h->tamanho - origem;
+}
+
+// Sondagem linear em que o elemento mais perto da origem cede a posição: ao encontrar um
+// elemento com distância menor que a do que está sendo inserido, os dois trocam de lugar e
+// a inserção continua com o deslocado. As distâncias ficam equilibradas e as buscas podem
+// parar assim que passam da distância do elemento da posição.
+static bool rh_inserir(Hash *h, TipoElemento *elemento){
+	TipoElemento atual = *elemento;
+	int pos = hash_funcao(h, atual.chave);
+
+	for (int dist = 0; dist < h->tamanho; dist++) {
+		if (h->controle[pos] == CONTROLE_VAZIO) {
+			h->registros[pos] = atual;
+			h->controle[pos] = rh_controle(dist);
+			h->qtde++;
+			return true;
+		}
+		h->colisoes++; // Incrementa o contador de colisões
+
+		int d = rh_distancia(h, pos);
+		if (d < dist) {
+			TipoElemento tmp = h->registros[pos];
+			h->registros[pos] = atual;
+			h->controle[pos] = rh_controle(dist);
+			atual = tmp;
+			dist = d;
+		}
+		if (++pos == h->tamanho) pos = 0;
+	}
+	return false; // tabela cheia
+}
+
+// Posição da chave ou -1, sondando a partir da origem pos. A busca termina em uma posição vazia ou assim que a distância
+// percorrida passa da do elemento da posição: se a chave estivesse adiante, ele teria cedido o lugar.
+static int rh_localizar(Hash *h, int chave, int pos){
+	for (int dist = 0; dist < h->tamanho; dist++) {
+		unsigned char c = h->controle[pos];
+		if (c == CONTROLE_VAZIO) return -1;
+		if (c != RH_REMOVIDO) {
+			if (c < RH_SATURADO && c - 1 < dist) return -1;
+			if (h->registros[pos].chave == chave) return pos;
+		}
+		if (++pos == h->tamanho) pos = 0;
+	}
+	return -1;
+}
+
+// Remoção por deslocamento para trás do modo Robin Hood: os elementos seguintes que não estão
+// na origem recuam uma posição (e ficam uma posição mais perto dela) até uma vazia ou um elemento na origem
+static void rh_deslocar_para_tras(Hash *h, int buraco){
+	int j = buraco + 1 == h->tamanho ? 0 : buraco + 1;
+	while (h->controle[j] != CONTROLE_VAZIO && h->controle[j] != RH_REMOVIDO && h->controle[j] > 1) {
+		h->registros[buraco] = h->registros[j];
+		h->controle[buraco] = h->controle[j] < RH_SATURADO ? h->controle[j] - 1 : rh_controle(rh_distancia(h, j) - 1);
+		buraco = j;
+		if (++j == h->tamanho) j = 0;
+	}
+	h->controle[buraco] = CONTROLE_VAZIO;
+}
+
+// Hash de 64 bits da chave no modo cuckoo (finalizador do splitmix64 sobre a chave e a semente
+// da tabela): as duas metades escolhem os dois baldes da chave de forma independente
+static uint64_t cuckoo_misturar(Hash *h, int chave){
+	uint64_t x = (uint32_t) chave ^ h->semente;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+static int cuckoo_baldes(Hash *h){
+	return (h->tamanho - CUCKOO_ESTOQUE) / CUCKOO_VIAS;
+}
+
+// Os dois baldes possíveis da chave de hash x (diferentes sempre que há mais de um balde)
+static void cuckoo_candidatos(Hash *h, uint64_t x, int *b1, int *b2){
+	int baldes = cuckoo_baldes(h);
+	*b1 = hash_reduzir((uint32_t) (x >> 32), baldes);
+	*b2 = hash_reduzir((uint32_t) x, baldes);
+	if (*b2 == *b1 && baldes > 1) *b2 = *b1 + 1 == baldes ? 0 : *b1 + 1;
+}
+
+// Primeira posição livre do balde ou -1
+static int cuckoo_livre(Hash *h, int balde){
+	for (int i = 0; i < CUCKOO_VIAS; i++)
+		if (h->controle[balde * CUCKOO_VIAS + i] == CONTROLE_VAZIO) return balde * CUCKOO_VIAS + i;
+	return -1;
+}
+
+// Posição da chave no balde ou -1. As chaves são comparadas antes dos bytes de controle, de modo
+// que uma busca sem sucesso só lê a linha dos registros do balde.
+static int cuckoo_procurar(Hash *h, int balde, int chave){
+	for (int pos = balde * CUCKOO_VIAS; pos < (balde + 1) * CUCKOO_VIAS; pos++)
+		if (h->registros[pos].chave == chave && h->controle[pos] != CONTROLE_VAZIO) return pos;
+	return -1;
+}
+
+// Posição da chave de hash x ou -1: no máximo dois baldes e, se não estiver vazio, o estoque
+static int cuckoo_localizar(Hash *h, int chave, uint64_t x){
+	int b1, b2;
+	cuckoo_candidatos(h, x, &b1, &b2);
+	int pos = cuckoo_procurar(h, b1, chave);
+	if (pos < 0) pos = cuckoo_procurar(h, b2, chave);
+	if (pos < 0 && h->estoque > 0) {
+		for (int i = h->tamanho - CUCKOO_ESTOQUE; i < h->tamanho; i++)
+			if (h->controle[i] != CONTROLE_VAZIO && h->registros[i].chave == chave) return i;
+	}
+	return pos;
+}
+
+static void cuckoo_gravar(Hash *h, int pos, const TipoElemento *elemento){
+	h->registros[pos] = *elemento;
+	h->controle[pos] = CONTROLE_OCUPADO;
+}
+
+// Insere em um dos dois baldes da chave. Se ambos estiverem cheios, uma busca em largura a partir
+// deles procura o caminho de despejo mais curto: uma sequência de elementos em que cada um pode
+// ir para o seu outro balde, terminando em um balde com posição livre. Os elementos do caminho
+// são movidos do fim para o começo e o novo ocupa a posição liberada no primeiro balde.
+// Sem caminho, o elemento vai para o estoque; com o estoque cheio a inserção falha.
+static bool cuckoo_inserir(Hash *h, TipoElemento *elemento){
+	int b1, b2;
+	cuckoo_candidatos(h, cuckoo_misturar(h, elemento->chave), &b1, &b2);
+
+	int pos = cuckoo_livre(h, b1);
+	if (pos < 0) pos = cuckoo_livre(h, b2);
+	if (pos >= 0) {
+		cuckoo_gravar(h, pos, elemento);
+		h->qtde++;
+		return true;
+	}
+
+	// Fila da busca em largura: balde visitado, nó que o alcançou e posição (no balde do pai)
+	// do elemento que se move para ele
+	int balde[CUCKOO_BFS], pai[CUCKOO_BFS], origem[CUCKOO_BFS];
+	int fim = 0;
+	balde[fim] = b1; pai[fim] = -1; origem[fim++] = -1;
+	if (b2 != b1) { balde[fim] = b2; pai[fim] = -1; origem[fim++] = -1; }
+
+	for (int inicio = 0; inicio < fim; inicio++) {
+		for (int i = 0; i < CUCKOO_VIAS; i++) {
+			int p = balde[inicio] * CUCKOO_VIAS + i;
+			int c1, c2;
+			cuckoo_candidatos(h, cuckoo_misturar(h, h->registros[p].chave), &c1, &c2);
+			int alternativo = c1 == balde[inicio] ? c2 : c1;
+
+			int livre = cuckoo_livre(h, alternativo);
+			if (livre >= 0) {
+				// Caminho encontrado: move cada elemento para o seu balde alternativo, do fim para o começo
+				int destino = livre;
+				for (int no = inicio, de = p; no >= 0; de = origem[no], no = pai[no]) {
+					h->registros[destino] = h->registros[de];
+					h->controle[destino] = CONTROLE_OCUPADO;
+					h->colisoes++; // cada despejo conta como colisão
+					destino = de;
+					if (pai[no] < 0) break;
+				}
+				cuckoo_gravar(h, destino, elemento);
+				h->qtde++;
+				return true;
+			}
+
+			// Enfileira o balde alternativo, se ainda não foi visitado (um balde por caminho evita
+			// que o mesmo elemento seja movido duas vezes)
+			bool visitado = false;
+			for (int j = 0; j < fim && !visitado; j++) visitado = balde[j] == alternativo;
+			if (!visitado && fim < CUCKOO_BFS) {
+				balde[fim] = alternativo; pai[fim] = inicio; origem[fim++] = p;
+			}
+		}
+	}
+
+	for (pos = h->tamanho - CUCKOO_ESTOQUE; pos < h->tamanho; pos++) {
+		if (h->controle[pos] == CONTROLE_VAZIO) {
+			cuckoo_gravar(h, pos, elemento);
+			h->qtde++;
+			h->estoque++;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Devolve aos baldes os elementos do estoque que voltaram a caber (depois de uma remoção)
+static void cuckoo_esvaziar_estoque(Hash *h){
+	for (int pos = h->tamanho - CUCKOO_ESTOQUE; pos < h->tamanho && h->estoque > 0; pos++) {
+		if (h->controle[pos] == CONTROLE_VAZIO) continue;
+		int b1, b2;
+		cuckoo_candidatos(h, cuckoo_misturar(h, h->registros[pos].chave), &b1, &b2);
+		int livre = cuckoo_livre(h, b1);
+		if (livre < 0) livre = cuckoo_livre(h, b2);
+		if (livre >= 0) {
+			cuckoo_gravar(h, livre, &h->registros[pos]);
+			h->controle[pos] = CONTROLE_VAZIO;
+			h->estoque--;
+		}
+	}
+}
+
+// Modos com sondagem própria, que todas as funções de inserção, busca e remoção usam
+static bool hash_sondagem_propria(Hash *h){
+	return h->modo == HASH_SIMD || h->modo == HASH_ROBIN_HOOD || h->modo == HASH_CUCKOO;
+}
+
+// Inserção em uma única tabela, sem considerar migração
+static bool tabela_inserir(Hash *h, TipoElemento *elemento, Sondagem sondagem){
+	if (h->modo == HASH_SIMD) return simd_inserir(h, elemento);
+	if (h->modo == HASH_ROBIN_HOOD) return rh_inserir(h, elemento);
+	if (h->modo == HASH_CUCKOO) return cuckoo_inserir(h, elemento);
+	return sondagem_inserir(h, elemento, sondagem);
+}
+
+// Início da sondagem da chave: a posição de origem ou, nos modos SIMD e cuckoo, o hash de 64 bits
+// (que dá o grupo inicial e a impressão H2, ou os dois baldes)
+static uint64_t tabela_origem(Hash *h, int chave){
+	if (h->modo == HASH_SIMD) return simd_misturar(chave);
+	if (h->modo == HASH_CUCKOO) return cuckoo_misturar(h, chave);
+	return (uint64_t) hash_funcao(h, chave);
+}
+
+// Busca em uma única tabela a partir da origem já calculada, sem considerar migração
+static int tabela_localizar_origem(Hash *h, int chave, uint64_t origem, Sondagem sondagem){
+	if (h->modo == HASH_SIMD) return simd_localizar(h, chave, origem);
+	if (h->modo == HASH_ROBIN_HOOD) return rh_localizar(h, chave, (int) origem);
+	if (h->modo == HASH_CUCKOO) return cuckoo_localizar(h, chave, origem);
+	return sondagem_localizar(h, chave, (int) origem, sondagem);
+}
+
+// Busca em uma única tabela, sem considerar migração
+static int tabela_localizar(Hash *h, int chave, Sondagem sondagem){
+	return tabela_localizar_origem(h, chave, tabela_origem(h, chave), sondagem);
+}
+
+// Traz para a cache as linhas da origem da sondagem (no modo ponteiro, a posição do vetor de ponteiros)
+static void tabela_prefetch(Hash *h, uint64_t origem){
+	if (h->modo == HASH_SIMD) {
+		int g = (int) (origem >> 7) & (h->tamanho / GRUPO - 1);
+		__builtin_prefetch(h->controle + g * GRUPO);
+		__builtin_prefetch(&h->registros[g * GRUPO]);
+	} else if (h->modo == HASH_CUCKOO) {
+		int b1, b2;
+		cuckoo_candidatos(h, origem, &b1, &b2);
+		__builtin_prefetch(&h->registros[b1 * CUCKOO_VIAS]);
+		__builtin_prefetch(&h->registros[b2 * CUCKOO_VIAS]);
+	} else if (h->modo == HASH_PONTEIRO) {
+		__builtin_prefetch(&h->itens[origem]);
+	} else {
+		__builtin_prefetch(&h->controle[origem]);
+		__builtin_prefetch(&h->registros[origem]);
+	}
+}
+
+// Quantidade de passos da sondagem entre a origem do elemento da posição ocupada pos e pos
+// (no modo SIMD, passos entre grupos; no cuckoo, 0 no primeiro balde, 1 no segundo e 2 no estoque)
+static int tabela_distancia(Hash *t, int pos, Sondagem sondagem){
+	if (t->modo == HASH_ROBIN_HOOD) return rh_distancia(t, pos);
+	if (t->modo == HASH_CUCKOO) {
+		if (pos >= t->tamanho - CUCKOO_ESTOQUE) return 2;
+		int b1, b2;
+		cuckoo_candidatos(t, cuckoo_misturar(t, t->registros[pos].chave), &b1, &b2);
+		return pos / CUCKOO_VIAS == b1 ? 0 : 1;
+	}
+
+	int chave = hash_posicao(t, pos)->chave;
+	if (t->modo == HASH_SIMD) {
+		int mascara_grupos = t->tamanho / GRUPO - 1;
+		int g = (int) (simd_misturar(chave) >> 7) & mascara_grupos;
+		int passo = 0;
+		for (; g != pos / GRUPO && passo <= mascara_grupos; passo++)
+			g = (g + passo + 1) & mascara_grupos;
+		return passo;
+	}
+
+	int atual = hash_funcao(t, chave);
+	int h2 = sondagem == SONDAGEM_DUPLA ? hash_funcao_secundaria(t, chave) : 0;
+	int i = 0;
+	for (; atual != pos && i < t->tamanho; i++)
+		atual = hash_sondar(t, atual, h2, i, sondagem);
+	return i;
+}
+
+// Torna a posição virgem (modos ponteiro e inline)
+static void hash_esvaziar(Hash *h, int pos){
+	if (h->modo == HASH_INLINE) h->controle[pos] = CONTROLE_VAZIO;
+	else h->itens[pos] = NULL;
+}
+
+// Remoção com deslocamento para trás da sondagem linear: os elementos seguintes do mesmo
+// agrupamento cuja posição de origem não fica entre o buraco e eles são puxados para o
+// buraco, que então avança. No fim o buraco fica virgem e nenhuma marca de remoção é criada.
+static void hash_deslocar_para_tras(Hash *h, int buraco){
+	hash_esvaziar(h, buraco);
+	for (int j = (buraco + 1) % h->tamanho; !hash_posicao_virgem(h, j); j = (j + 1) % h->tamanho) {
+		TipoElemento *el = hash_posicao(h, j);
+		if (el == NULL) continue; // marca de remoção deixada por outra sondagem
+
+		// Distâncias circulares até j: da origem do elemento e do buraco
+		int origem = hash_funcao(h, el->chave);
+		int dist_origem = (j - origem + h->tamanho) % h->tamanho;
+		int dist_buraco = (j - buraco + h->tamanho) % h->tamanho;
+		if (dist_origem >= dist_buraco) {
+			if (h->modo == HASH_INLINE) {
+				h->registros[buraco] = *el;
+				h->controle[buraco] = CONTROLE_OCUPADO;
+			} else {
+				h->itens[buraco] = el;
+			}
+			hash_esvaziar(h, j);
+			buraco = j;
+		}
+	}
+}
+
+// Libera a posição de t e devolve o elemento em *elemento. Nos modos inline, SIMD e Robin Hood
+// a cópia fica em h->removido, pois a posição pode ser reaproveitada pela próxima inserção.
+// A sondagem linear e o modo Robin Hood usam deslocamento para trás na tabela atual; as demais
+// sondagens (e a tabela antiga, cujas posições já migradas não podem voltar a valer) usam marcas de remoção.
+static void tabela_retirar(Hash *h, Hash *t, int pos, TipoElemento **elemento, Sondagem sondagem){
+	if (t->modo == HASH_PONTEIRO) {
+		*elemento = t->itens[pos];
+	} else {
+		h->removido = t->registros[pos];
+		*elemento = &h->removido;
+	}
+	t->qtde--;
+
+	if (t->modo == HASH_SIMD) {
+		// Um grupo que ainda tem posição vazia nunca esteve cheio, logo nenhuma sondagem passou
+		// por ele e a posição pode voltar a ser vazia em vez de virar marca de remoção
+		const unsigned char *grupo = t->controle + (pos / GRUPO) * GRUPO;
+		bool vazio = grupo_comparar(grupo, SIMD_VAZIO) != 0;
+		t->controle[pos] = vazio ? SIMD_VAZIO : SIMD_REMOVIDO;
+		if (!vazio) t->removidos++;
+	} else if (t->modo == HASH_CUCKOO) {
+		// Sem sequências de sondagem, a posição volta a ser vazia. Só a tabela atual recebe de
+		// volta os elementos do estoque: na antiga eles poderiam cair em posições já migradas.
+		t->controle[pos] = CONTROLE_VAZIO;
+		if (pos >= t->tamanho - CUCKOO_ESTOQUE) t->estoque--;
+		else if (t == h) cuckoo_esvaziar_estoque(t);
+	} else if (t->modo == HASH_ROBIN_HOOD) {
+		if (t == h) {
+			rh_deslocar_para_tras(t, pos);
+		} else {
+			t->controle[pos] = RH_REMOVIDO;
+			t->removidos++;
+		}
+	} else if (sondagem == SONDAGEM_LINEAR && t == h) {
+		hash_deslocar_para_tras(t, pos);
+	} else {
+		if (t->modo == HASH_INLINE) t->controle[pos] = CONTROLE_REMOVIDO;
+		else t->itens[pos] = ITEM_REMOVIDO;
+		t->removidos++;
+	}
+}
+
+// Posição da chave na tabela antiga que ainda não foi migrada, ou -1
+static int hash_localizar_antiga(Hash *h, int chave, Sondagem sondagem){
+	if (h->antiga == NULL) return -1;
+	int pos = tabela_localizar(h->antiga, chave, sondagem);
+	return pos >= h->migrados ? pos : -1;
+}
+
+static bool primo(int n){
+	if (n < 2) return false;
+	for (int d = 2; (long) d * d <= n; d++)
+		if (n % d == 0) return false;
+	return true;
+}
+
+// Menor tamanho válido para o dimensionamento da política que seja maior ou igual a minimo
+static int hash_dimensionar(Hash *h, long minimo){
+	if (minimo > INT_MAX / 2) minimo = INT_MAX / 2;
+	if (h->modo == HASH_SIMD || h->politica.dimensionamento == HASH_POTENCIA_2) {
+		long tamanho = GRUPO;
+		while (tamanho < minimo) tamanho <<= 1;
+		return (int) tamanho;
+	}
+	int tamanho = (int) minimo;
+	while (!primo(tamanho)) tamanho++;
+	return tamanho;
+}
+
+static bool hash_preparar_tabulacao(Hash *h);
+
+// Troca o armazenamento (vetores, quantidade e tamanho) de duas tabelas do mesmo modo
+static void hash_trocar_armazenamento(Hash *a, Hash *b){
+	Hash tmp = *a;
+	a->itens = b->itens;         b->itens = tmp.itens;
+	a->registros = b->registros; b->registros = tmp.registros;
+	a->controle = b->controle;   b->controle = tmp.controle;
+	a->qtde = b->qtde;           b->qtde = tmp.qtde;
+	a->tamanho = b->tamanho;     b->tamanho = tmp.tamanho;
+	a->limite = b->limite;       b->limite = tmp.limite;
+	a->removidos = b->removidos; b->removidos = tmp.removidos;
+	a->estoque = b->estoque;     b->estoque = tmp.estoque;
+}
+
+// Move até passos posições da tabela antiga para a atual, na ordem dos índices. As posições
+// migradas não são apagadas na antiga, para não interromper as sondagens das chaves que ainda
+// estão lá; por isso a busca na antiga só aceita posições a partir de h->migrados.
+// Devolve false se a sondagem (quadrática, dupla ou cuckoo) não achou posição na tabela atual
+// para um elemento: ele fica na antiga, em h->migrados, e a migração para nele.
+static bool tabela_migrar(Hash *h, int passos){
+	Hash *antiga = h->antiga;
+	if (antiga == NULL) return true;
+
+	for (int i = 0; i < passos && h->migrados < antiga->tamanho; i++, h->migrados++) {
+		TipoElemento *el = hash_posicao(antiga, h->migrados);
+		if (el == NULL) continue;
+		if (!tabela_inserir(h, el, h->sondagem)) return false;
+		antiga->qtde--;
+	}
+
+	if (h->migrados == antiga->tamanho || antiga->qtde == 0)
+		hash_destruir(&h->antiga);
+	return true;
+}
+
+// Tabela vazia de tamanho posições (no modo SIMD, capacidade em elementos) com a mesma função
+// e sementes de h, para que os elementos de h mantenham as origens ao serem reinseridos
+static Hash* hash_criar_irma(Hash *h, int tamanho){
+	Hash *t = hash_criar_modo(tamanho, h->modo);
+	if (t == NULL) return NULL;
+	t->funcao = h->funcao;
+	t->semente = h->semente;
+	t->semente2 = h->semente2;
+	if (h->funcao == HASH_FUNCAO_TABULACAO && !hash_preparar_tabulacao(t)) hash_destruir(&t);
+	return t;
+}
+
+// Insere em t os elementos das posições [inicio, tamanho) de origem
+static bool tabela_copiar(Hash *t, Hash *origem, int inicio, Sondagem sondagem){
+	for (int pos = inicio; pos < origem->tamanho; pos++) {
+		TipoElemento *el = hash_posicao(origem, pos);
+		if (el != NULL && !tabela_inserir(t, el, sondagem)) return false;
+	}
+	return true;
+}
+
+// Conclui a migração de uma vez quando a tabela atual não acomoda um elemento da antiga: os
+// elementos das duas vão para uma tabela nova com o dobro de posições, que dobra de novo
+// enquanto algum não couber. Sem memória a migração fica parada e os elementos continuam
+// acessíveis nas duas tabelas; a próxima operação tenta outra vez.
+static void hash_reconstruir(Hash *h){
+	for (long minimo = 2L * h->tamanho; ; minimo *= 2) {
+		int posicoes = hash_dimensionar(h, minimo);
+		Hash *nova = hash_criar_irma(h, h->modo == HASH_SIMD ? (int) ((long) posicoes * SIMD_CARGA_NUM / SIMD_CARGA_DEN) : posicoes);
+		if (nova == NULL) return;
+		if (tabela_copiar(nova, h, 0, h->sondagem) && tabela_copiar(nova, h->antiga, h->migrados, h->sondagem)) {
+			hash_trocar_armazenamento(h, nova);
+			hash_destruir(&nova);
+			hash_destruir(&h->antiga);
+			return;
+		}
+		hash_destruir(&nova);
+		if (posicoes >= INT_MAX / 2) return;
+	}
+}
+
+// Migração feita pelas operações: se um elemento não couber, a tabela cresce de novo
+static void hash_migrar(Hash *h, int passos){
+	if (!tabela_migrar(h, passos)) hash_reconstruir(h);
+}
+
+// Redimensiona incrementalmente para posicoes posições (no modo SIMD o redimensionamento
+// recebe a capacidade em elementos, que ocupa 7/8 das posições)
+static bool hash_ajustar(Hash *h, int posicoes){
+	if (h->modo == HASH_SIMD)
+		return hash_redimensionar_incremental(h, (int) ((long) posicoes * SIMD_CARGA_NUM / SIMD_CARGA_DEN));
+	return hash_redimensionar_incremental(h, posicoes);
+}
+
+// Limite superior de carga da sondagem
+static float hash_limite_crescer(Hash *h, Sondagem sondagem){
+	if (h->modo == HASH_SIMD) return h->politica.crescer_simd;
+	if (h->modo == HASH_ROBIN_HOOD) return h->politica.crescer_robin_hood;
+	if (h->modo == HASH_CUCKOO) return h->politica.crescer_cuckoo;
+	switch (sondagem) {
+		case SONDAGEM_LINEAR:     return h->politica.crescer_linear;
+		case SONDAGEM_QUADRATICA: return h->politica.crescer_quadratica;
+		default:                  return h->politica.crescer_duplo;
+	}
+}
+
+// Redimensiona se a próxima inserção passaria do limite superior de carga. As marcas de
+// remoção alongam as sondagens como posições ocupadas e contam para o limite: se a maior parte
+// da ocupação for de marcas, a tabela é reconstruída no mesmo tamanho (descartando-as) em vez de dobrar.
+static void hash_crescer(Hash *h, Sondagem sondagem){
+	if (!h->politica_ativa) return;
+
+	float limite = hash_limite_crescer(h, sondagem) * h->tamanho;
+	if (!hash_cheio(h) && hash_tamanho(h) + h->removidos + 1 <= limite) return;
+
+	if (hash_cheio(h) || hash_tamanho(h) + 1 > limite / 2)
+		hash_ajustar(h, hash_dimensionar(h, 2L * h->tamanho));
+	else
+		hash_ajustar(h, h->tamanho);
+}
+
+// Encolhe a tabela para o meio da faixa entre os limites se a carga caiu abaixo do inferior
+static void hash_encolher(Hash *h){
+	if (!h->politica_ativa || h->tamanho <= h->tamanho_minimo) return;
+	if (hash_tamanho(h) >= h->politica.encolher * h->tamanho) return;
+
+	float alvo = (hash_limite_crescer(h, h->sondagem) + h->politica.encolher) / 2;
+	long posicoes = (long) (hash_tamanho(h) / alvo) + 1;
+	if (posicoes < h->tamanho_minimo) posicoes = h->tamanho_minimo;
+	posicoes = hash_dimensionar(h, posicoes);
+	if (posicoes < h->tamanho) hash_ajustar(h, (int) posicoes);
+}
+
+static bool hash_inserir_sondagem(Hash *h, TipoElemento *elemento, Sondagem sondagem){
+	if (!hash_ehValida(h) || elemento == NULL || h->mapa != NULL) return false;
+
+	hash_crescer(h, sondagem);
+	if (hash_cheio(h)) return false;
+
+	hash_migrar(h, MIGRACAO_PASSO);
+	h->sondagem = sondagem;
+	if (tabela_inserir(h, elemento, sondagem)) return true;
+	if (!h->politica_ativa) return false;
+
+	// A sondagem não encontrou posição livre (a quadrática, por exemplo, não visita todas):
+	// com a política ativa a tabela dobra de uma vez e a inserção é repetida. Se a sondagem também
+	// não acomodar algum elemento no novo tamanho (o redimensionamento desfaz) ou o novo, dobra de novo.
+	for (long minimo = 2L * h->tamanho; ; minimo *= 2) {
+		int posicoes = hash_dimensionar(h, minimo);
+		if (hash_redimensionar(h, h->modo == HASH_SIMD ? (int) ((long) posicoes * SIMD_CARGA_NUM / SIMD_CARGA_DEN) : posicoes)
+			&& tabela_inserir(h, elemento, sondagem))
+			return true;
+		if (posicoes >= INT_MAX / 2) return false;
+	}
 }
 
+static bool hash_buscar_sondagem(Hash *h, int chave, TipoElemento **elemento, Sondagem sondagem){
+	if (!hash_ehValida(h) || elemento == NULL) return false;
+
+	hash_migrar(h, MIGRACAO_PASSO);
+	int pos = tabela_localizar(h, chave, sondagem);
+	if (pos >= 0) {
+		*elemento = hash_posicao(h, pos);
+		return true;
+	}
+	pos = hash_localizar_antiga(h, chave, sondagem);
+	if (pos >= 0) {
+		*elemento = hash_posicao(h->antiga, pos);
+		return true;
+	}
+	return false;
+}
+
+static bool hash_remover_sondagem(Hash *h, int chave, TipoElemento **elemento, Sondagem sondagem){
+	if (!hash_ehValida(h) || elemento == NULL || h->mapa != NULL) return false;
+
+	hash_migrar(h, MIGRACAO_PASSO);
+	int pos = tabela_localizar(h, chave, sondagem);
+	if (pos >= 0) {
+		tabela_retirar(h, h, pos, elemento, sondagem);
+	} else if ((pos = hash_localizar_antiga(h, chave, sondagem)) >= 0) {
+		tabela_retirar(h, h->antiga, pos, elemento, sondagem);
+	} else {
+		return false;
+	}
+
+	// No modo ponteiro o elemento é do chamador, então o encolhimento (que pode mover
+	// registros dos modos inline e SIMD) só acontece depois de *elemento ser copiado
+	hash_encolher(h);
+	return true;
+}
 
 /**************************************
 * IMPLEMENTAÇÃO
 **************************************/
 
 Hash* hash_criar(int tamanho){
+	return hash_criar_modo(tamanho, HASH_PONTEIRO);
+}
+
+Hash* hash_criar_modo(int tamanho, HashModo modo){
 	if (tamanho <= 0) return NULL;
 
-	Hash *h = (Hash*) malloc(sizeof(Hash)); 
+	// Alinhada à linha de cache: contadores de tabelas usadas por threads diferentes nunca a compartilham
+	Hash *h = (Hash*) aligned_alloc(LINHA_CACHE, (sizeof(Hash) + LINHA_CACHE - 1) / LINHA_CACHE * LINHA_CACHE);
 	if (h == NULL) return NULL;
 
-	h->itens = (TipoElemento**) malloc(sizeof(TipoElemento)*tamanho); 
-	if (h->itens == NULL) {
-		free(h);
-		return NULL;
-	}
+	h->itens = NULL;
+	h->registros = NULL;
+	h->controle = NULL;
+	h->tamanho = tamanho;
+	h->limite = tamanho;
+
+	if (modo == HASH_SIMD) {
+		if (!simd_alocar(h, tamanho)) { // ajusta tamanho para as posições efetivamente alocadas
+			free(h);
+			return NULL;
+		}
+	} else if (modo == HASH_CUCKOO) {
+		// Baldes inteiros mais o estoque; os registros ficam alinhados à linha de cache para que
+		// nenhum balde de 32 bytes fique dividido entre duas linhas
+		long baldes = ((long) tamanho + CUCKOO_VIAS - 1) / CUCKOO_VIAS;
+		if (baldes * CUCKOO_VIAS + CUCKOO_ESTOQUE > INT32_MAX) {
+			free(h);
+			return NULL;
+		}
+		h->tamanho = (int) (baldes * CUCKOO_VIAS + CUCKOO_ESTOQUE);
+		h->limite = h->tamanho;
+		size_t bytes = (sizeof(TipoElemento) * h->tamanho + LINHA_CACHE - 1) / LINHA_CACHE * LINHA_CACHE;
+		h->registros = (TipoElemento*) aligned_alloc(LINHA_CACHE, bytes);
+		h->controle = (unsigned char*) calloc(h->tamanho, sizeof(unsigned char)); // CONTROLE_VAZIO
+		if (h->registros == NULL || h->controle == NULL) {
+			free(h->registros);
+			free(h->controle);
+			free(h);
+			return NULL;
+		}
+	} else if (modo == HASH_INLINE || modo == HASH_ROBIN_HOOD) {
+		// Zerados para que as posições livres gravadas por hash_salvar não levem lixo da memória
+		h->registros = (TipoElemento*) calloc(tamanho, sizeof(TipoElemento));
+		h->controle = (unsigned char*) calloc(tamanho, sizeof(unsigned char)); // CONTROLE_VAZIO
+		if (h->registros == NULL || h->controle == NULL) {
+			free(h->registros);
+			free(h->controle);
+			free(h);
+			return NULL;
+		}
+	} else {
+		h->itens = (TipoElemento**) malloc(sizeof(TipoElemento*)*tamanho);
+		if (h->itens == NULL) {
+			free(h);
+			return NULL;
+		}
 
-	for (int i=0; i<tamanho;i++){
-		h->itens[i] = NULL;
+		for (int i=0; i<tamanho;i++){
+			h->itens[i] = NULL;
+		}
 	}
 
 	h->qtde = 0;
-	h->tamanho = tamanho;
+	h->removidos = 0;
+	h->estoque = 0;
 	h->colisoes = 0; // Inicializa o contador de colisões
+	h->modo = modo;
+	h->sondagem = SONDAGEM_LINEAR;
+	h->antiga = NULL;
+	h->migrados = 0;
+	h->politica_ativa = false;
+	h->politica = hash_politica_padrao();
+	h->tamanho_minimo = h->tamanho;
+	h->funcao = HASH_FUNCAO_DIVISAO;
+	h->semente = hash_semente_aleatoria();
+	h->semente2 = hash_semente_aleatoria();
+	h->tabulacao = NULL;
+	h->mapa = NULL;
+	h->mapa_bytes = 0;
 
 	return h;
 }
 
+HashModo hash_modo(Hash *h){
+	if (!hash_ehValida(h)) return HASH_PONTEIRO;
+	return h->modo;
+}
+
 void  hash_destruir(Hash** enderecoHash){
 	if (enderecoHash == NULL) return;
 	if (!hash_ehValida(*enderecoHash)) return;
 
 	Hash *h = *enderecoHash;
-	free(h->itens);
+	hash_destruir(&h->antiga);
+	if (h->mapa != NULL) {
+		munmap(h->mapa, h->mapa_bytes); // os vetores apontam para o mapeamento
+	} else {
+		free(h->itens);
+		free(h->registros);
+		free(h->controle);
+		free(h->tabulacao);
+	}
 	free(h);
 	*enderecoHash = NULL;
 }
 
 bool hash_inserir(Hash *h, TipoElemento *elemento){
-	if (!hash_ehValida(h) || elemento == NULL) return false;
+	if (!hash_ehValida(h) || elemento == NULL || h->mapa != NULL) return false;
+	if (hash_sondagem_propria(h)) return hash_inserir_sondagem(h, elemento, SONDAGEM_LINEAR);
 
+	hash_migrar(h, MIGRACAO_PASSO);
 	int pos = hash_funcao(h, elemento->chave);
-	if (h->itens[pos] != NULL) return false; // Não há tratamento de colisão
-	h->itens[pos] = elemento;
-	h->qtde++;
+	if (hash_posicao(h, pos) != NULL) return false; // Não há tratamento de colisão
+	hash_gravar(h, pos, elemento);
 	return true;
 }
 
 bool hash_remover(Hash *h, int chave, TipoElemento **elemento){
-	if (!hash_ehValida(h) || elemento == NULL) return false;
+	if (!hash_ehValida(h) || elemento == NULL || h->mapa != NULL) return false;
+	if (hash_sondagem_propria(h)) return hash_remover_sondagem(h, chave, elemento, SONDAGEM_LINEAR);
 
+	hash_migrar(h, MIGRACAO_PASSO);
 	int pos = hash_funcao(h, chave);
-	if (h->itens[pos] == NULL) return false; // Não considera tratamento de colisão
-	*elemento = h->itens[pos];  
-	h->itens[pos] = NULL;
-	h->qtde--;
-
-	return true;
+	if (hash_posicao(h, pos) != NULL) { // Não considera tratamento de colisão
+		tabela_retirar(h, h, pos, elemento, SONDAGEM_LINEAR);
+		return true;
+	}
+	if (h->antiga != NULL) {
+		pos = hash_funcao(h->antiga, chave);
+		if (pos >= h->migrados && hash_posicao(h->antiga, pos) != NULL) {
+			tabela_retirar(h, h->antiga, pos, elemento, SONDAGEM_LINEAR);
+			return true;
+		}
+	}
+	return false;
 }
 
 int hash_tamanho(Hash *ha){
 	if (!hash_ehValida(ha)) return -1;
-	return ha->qtde;
+	return ha->qtde + (ha->antiga != NULL ? ha->antiga->qtde : 0);
 }
 
 bool hash_cheio(Hash *ha){
 	if (!hash_ehValida(ha)) return false;
-	return (ha->qtde == ha->tamanho);
+	if (ha->modo == HASH_SIMD) return (hash_tamanho(ha) == ha->limite);
+	return (hash_tamanho(ha) == ha->tamanho);
 }
 
 bool hash_vazio(Hash *ha){
 	if (!hash_ehValida(ha)) return true;
-	if (ha->qtde == 0)
+	if (hash_tamanho(ha) == 0)
 		return true;
 	return false;
 }
@@ -107,237 +1098,464 @@ void hash_imprimir(Hash *h){
 
 	printf("[");
 	for (int i = 0; i < h->tamanho-1;i++){
-		if(h->itens[i] != NULL){
-			printf("%d, ", h->itens[i]->chave);
+		if(hash_posicao(h, i) != NULL){
+			printf("%d, ", hash_posicao(h, i)->chave);
 		}
 		else{
 			printf("NULL, ");
 		}
 	}
-	if(h->itens[h->tamanho-1] != NULL){
-		printf("%d", h->itens[h->tamanho-1]->chave);	
+	if(hash_posicao(h, h->tamanho-1) != NULL){
+		printf("%d", hash_posicao(h, h->tamanho-1)->chave);
 	}else{
 		printf("NULL");
 	}
-	
+
 	printf("]\n");
+
+	if (h->antiga != NULL) {
+		printf("Migrando (posições %d a %d da tabela antiga): [", h->migrados, h->antiga->tamanho-1);
+		for (int i = h->migrados; i < h->antiga->tamanho; i++) {
+			TipoElemento *el = hash_posicao(h->antiga, i);
+			if (el != NULL) printf("%d%s", el->chave, i < h->antiga->tamanho-1 ? ", " : "");
+			else printf("NULL%s", i < h->antiga->tamanho-1 ? ", " : "");
+		}
+		printf("]\n");
+	}
 }
 
 // Novas Funções
 
 bool hash_inserir_linear(Hash *h, TipoElemento *elemento){
-	if (!hash_ehValida(h) || elemento == NULL || hash_cheio(h)) return false;
+	return hash_inserir_sondagem(h, elemento, SONDAGEM_LINEAR);
+}
 
-	int pos = hash_funcao(h, elemento->chave);
-	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (pos + i) % h->tamanho;
-		if (h->itens[newPos] == NULL) {
-			h->itens[newPos] = elemento;
-			h->qtde++;
-			return true;
-		} else {
-			h->colisoes++; // Incrementa o contador de colisões
-		}
+bool hash_inserir_quadratica(Hash *h, TipoElemento *elemento){
+	return hash_inserir_sondagem(h, elemento, SONDAGEM_QUADRATICA);
+}
+
+int hash_funcao_secundaria(Hash* h, int chave) {
+	if (!hash_ehValida(h)) return 1;
+
+	// Passo independente da posição inicial: na divisão, o resto por tamanho - 1; nas demais, a metade
+	// baixa do hash ou, na multiplicação-deslocamento (cujos bits baixos são fracos), uma segunda
+	// multiplicação com os papéis das sementes trocados
+	int passo;
+	if (h->funcao == HASH_FUNCAO_DIVISAO) {
+		passo = 1 + (chave % (h->tamanho - 1));
+	} else {
+		uint32_t x;
+		if (h->funcao == HASH_FUNCAO_MULT_SHIFT)
+			x = (uint32_t) (((h->semente2 | 1) * (uint64_t) (uint32_t) chave + h->semente) >> 32);
+		else
+			x = (uint32_t) hash_calcular(h, chave);
+		passo = 1 + hash_reduzir(x, h->tamanho - 1);
 	}
+	if ((h->tamanho & (h->tamanho - 1)) == 0) passo |= 1; // em potências de 2 só passos ímpares visitam todas as posições
+	return passo;
+}
 
-	return false; // tabela cheia
+// Gera as tabelas aleatórias da tabulação a partir das sementes
+static bool hash_preparar_tabulacao(Hash *h){
+	if (h->tabulacao == NULL) {
+		h->tabulacao = malloc(sizeof(uint64_t[TABULACAO_TABELAS][256]));
+		if (h->tabulacao == NULL) return false;
+	}
+	uint64_t estado = h->semente ^ h->semente2;
+	for (int i = 0; i < TABULACAO_TABELAS; i++)
+		for (int j = 0; j < 256; j++)
+			h->tabulacao[i][j] = splitmix64(&estado);
+	return true;
 }
 
-bool hash_inserir_quadratica(Hash *h, TipoElemento *elemento){
-	if (!hash_ehValida(h) || elemento == NULL || hash_cheio(h)) return false;
+bool hash_definir_funcao(Hash *h, HashFuncao funcao, uint64_t semente) {
+	if (!hash_ehValida(h) || hash_tamanho(h) > 0 || h->mapa != NULL) return false; // as posições dependem da função
 
-	int pos = hash_funcao(h, elemento->chave);
-	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (pos + i*i) % h->tamanho;
-		if (h->itens[newPos] == NULL) {
-			h->itens[newPos] = elemento;
-			h->qtde++;
-			return true;
-		} else {
-			h->colisoes++; // Incrementa o contador de colisões
-		}
+	if (semente != 0) {
+		h->semente = splitmix64(&semente);
+		h->semente2 = splitmix64(&semente);
 	}
-
-	return false;
+	if (funcao == HASH_FUNCAO_TABULACAO && !hash_preparar_tabulacao(h)) return false;
+	h->funcao = funcao;
+	return true;
 }
 
-int hash_funcao_secundaria(Hash* h, int chave) {
-	if (!hash_ehValida(h)) return 1;
-	return 1 + (chave % (h->tamanho - 1));
+HashFuncao hash_funcao_atual(Hash *h) {
+	if (!hash_ehValida(h)) return HASH_FUNCAO_DIVISAO;
+	return h->funcao;
 }
 
 bool hash_inserir_duplo(Hash *h, TipoElemento *elemento){
-	if (!hash_ehValida(h) || elemento == NULL || hash_cheio(h)) return false;
+	return hash_inserir_sondagem(h, elemento, SONDAGEM_DUPLA);
+}
 
-	int h1 = hash_funcao(h, elemento->chave);
-	int h2 = hash_funcao_secundaria(h, elemento->chave);
+bool hash_buscar_linear(Hash *h, int chave, TipoElemento **elemento) {
+	return hash_buscar_sondagem(h, chave, elemento, SONDAGEM_LINEAR);
+}
 
-	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (h1 + i * h2) % h->tamanho;
-		if (h->itens[newPos] == NULL) {
-			h->itens[newPos] = elemento;
-			h->qtde++;
-			return true;
-		} else {
-			h->colisoes++; // Incrementa o contador de colisões
-		}
-	}
+bool hash_buscar_quadratica(Hash *h, int chave, TipoElemento **elemento) {
+	return hash_buscar_sondagem(h, chave, elemento, SONDAGEM_QUADRATICA);
+}
 
-	return false;
+bool hash_buscar_duplo(Hash *h, int chave, TipoElemento **elemento) {
+	return hash_buscar_sondagem(h, chave, elemento, SONDAGEM_DUPLA);
 }
 
-bool hash_buscar_linear(Hash *h, int chave, TipoElemento **elemento) {
-	if (!hash_ehValida(h) || elemento == NULL) return false;
+bool hash_remover_linear(Hash *h, int chave, TipoElemento **elemento) {
+	return hash_remover_sondagem(h, chave, elemento, SONDAGEM_LINEAR);
+}
 
-	int pos = hash_funcao(h, chave);
-	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (pos + i) % h->tamanho;
-		if (h->itens[newPos] == NULL) return false;
-		if (h->itens[newPos]->chave == chave) {
-			*elemento = h->itens[newPos];
-			return true;
-		}
-	}
-	return false;
+bool hash_remover_quadratica(Hash *h, int chave, TipoElemento **elemento) {
+	return hash_remover_sondagem(h, chave, elemento, SONDAGEM_QUADRATICA);
 }
 
-bool hash_buscar_quadratica(Hash *h, int chave, TipoElemento **elemento) {
-	if (!hash_ehValida(h) || elemento == NULL) return false;
+bool hash_remover_duplo(Hash *h, int chave, TipoElemento **elemento) {
+	return hash_remover_sondagem(h, chave, elemento, SONDAGEM_DUPLA);
+}
 
-	int pos = hash_funcao(h, chave);
+void hash_listar(Hash *h){
+	if (!hash_ehValida(h)) return;
+
+	printf("Elementos armazenados:\n");
 	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (pos + i*i) % h->tamanho;
-		if (h->itens[newPos] == NULL) return false;
-		if (h->itens[newPos]->chave == chave) {
-			*elemento = h->itens[newPos];
-			return true;
+		TipoElemento *el = hash_posicao(h, i);
+		if (el != NULL) {
+			printf("Pos[%d]: Chave=%d, Dado=%d\n", i, el->chave, el->dado);
+		}
+	}
+	for (int i = h->migrados; h->antiga != NULL && i < h->antiga->tamanho; i++) {
+		TipoElemento *el = hash_posicao(h->antiga, i);
+		if (el != NULL) {
+			printf("Antiga[%d]: Chave=%d, Dado=%d\n", i, el->chave, el->dado);
 		}
 	}
+}
+
+float hash_fator_carga(Hash *h) {
+	if (!hash_ehValida(h) || h->tamanho == 0) return 0.0f;
+	return (float) hash_tamanho(h) / h->tamanho;
+}
+
+bool hash_redimensionar_incremental(Hash *h, int novo_tamanho) {
+	if (!hash_ehValida(h) || novo_tamanho <= hash_tamanho(h) || h->mapa != NULL) return false;
+
+	// Só existe uma tabela antiga por vez: conclui a migração anterior
+	hash_migrar(h, INT_MAX);
+
+	// As duas tabelas usam a mesma função e sementes: a antiga continua achando suas chaves
+	Hash *antiga = hash_criar_irma(h, novo_tamanho);
+	if (antiga == NULL) return false;
+
+	// A tabela h passa a usar os vetores novos e vazios; a antiga fica com os atuais
+	hash_trocar_armazenamento(h, antiga);
+	h->antiga = antiga;
+	h->migrados = 0;
+	if (antiga->qtde == 0) hash_destruir(&h->antiga);
+
+	return true;
+}
+
+bool hash_redimensionando(Hash *h) {
+	if (!hash_ehValida(h)) return false;
+	return h->antiga != NULL;
+}
+
+bool hash_redimensionar(Hash *h, int novo_tamanho) {
+	if (!hash_redimensionar_incremental(h, novo_tamanho)) return false;
+
+	// Reinsere de uma vez todos os elementos, com a sondagem da última inserção
+	if (tabela_migrar(h, INT_MAX)) return true;
+
+	// A sondagem não visitou posição livre para algum elemento no novo tamanho: volta aos vetores
+	// antigos, que ainda guardam todos os elementos (as posições migradas não são apagadas)
+	Hash *nova = h->antiga;
+	nova->qtde += h->qtde;
+	hash_trocar_armazenamento(h, nova);
+	h->antiga = NULL;
+	hash_destruir(&nova);
 	return false;
 }
 
-bool hash_buscar_duplo(Hash *h, int chave, TipoElemento **elemento) {
-	if (!hash_ehValida(h) || elemento == NULL) return false;
+HashPolitica hash_politica_padrao(void) {
+	HashPolitica politica = { 0.7f, 0.8f, 0.8f, 0.875f, 0.9f, 0.93f, 0.2f, HASH_PRIMO };
+	return politica;
+}
 
-	int h1 = hash_funcao(h, chave);
-	int h2 = hash_funcao_secundaria(h, chave);
+bool hash_definir_politica(Hash *h, const HashPolitica *politica) {
+	if (!hash_ehValida(h) || h->mapa != NULL) return false;
+	if (politica == NULL) {
+		h->politica_ativa = false;
+		return true;
+	}
 
-	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (h1 + i * h2) % h->tamanho;
-		if (h->itens[newPos] == NULL) return false;
-		if (h->itens[newPos]->chave == chave) {
-			*elemento = h->itens[newPos];
-			return true;
-		}
+	float crescer[] = { politica->crescer_linear, politica->crescer_quadratica, politica->crescer_duplo,
+		politica->crescer_simd, politica->crescer_robin_hood, politica->crescer_cuckoo };
+	for (int i = 0; i < (int) (sizeof(crescer) / sizeof(crescer[0])); i++) {
+		// O limite inferior precisa ficar abaixo da metade do superior, senão dobrar a tabela já a faria encolher
+		if (crescer[i] <= 0 || crescer[i] > 1 || politica->encolher < 0 || politica->encolher * 2 >= crescer[i])
+			return false;
 	}
-	return false;
+	if (politica->crescer_simd > (float) SIMD_CARGA_NUM / SIMD_CARGA_DEN) return false;
+
+	h->politica = *politica;
+	h->politica_ativa = true;
+	return true;
 }
 
-bool hash_remover_linear(Hash *h, int chave, TipoElemento **elemento) {
-	if (!hash_ehValida(h) || elemento == NULL) return false;
+int hash_removidos(Hash *h){
+	if (!hash_ehValida(h)) return -1;
+	return h->removidos + (h->antiga != NULL ? h->antiga->removidos : 0);
+}
 
-	int pos = hash_funcao(h, chave);
-	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (pos + i) % h->tamanho;
-		if (h->itens[newPos] == NULL) return false;
-		if (h->itens[newPos]->chave == chave) {
-			*elemento = h->itens[newPos];
-			h->itens[newPos] = NULL;
-			h->qtde--;
-			return true;
-		}
+int hash_colisoes(Hash *h){
+	if (!hash_ehValida(h)) return -1;
+	return h->colisoes;
+}
+
+// Acumula no histograma as distâncias das posições ocupadas de t a partir de inicio e devolve a maior
+static int tabela_histograma(Hash *t, int inicio, Sondagem sondagem, int histograma[], int classes){
+	int maximo = 0;
+	for (int pos = inicio; pos < t->tamanho; pos++) {
+		if (hash_posicao(t, pos) == NULL) continue;
+		int dist = tabela_distancia(t, pos, sondagem);
+		if (dist > maximo) maximo = dist;
+		if (classes > 0) histograma[dist < classes ? dist : classes - 1]++;
 	}
-	return false;
+	return maximo;
 }
 
-bool hash_remover_quadratica(Hash *h, int chave, TipoElemento **elemento) {
-	if (!hash_ehValida(h) || elemento == NULL) return false;
+int hash_histograma_sondagem(Hash *h, int histograma[], int classes){
+	if (!hash_ehValida(h) || (classes > 0 && histograma == NULL)) return -1;
 
-	int pos = hash_funcao(h, chave);
-	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (pos + i*i) % h->tamanho;
-		if (h->itens[newPos] == NULL) return false;
-		if (h->itens[newPos]->chave == chave) {
-			*elemento = h->itens[newPos];
-			h->itens[newPos] = NULL;
-			h->qtde--;
-			return true;
-		}
+	for (int i = 0; i < classes; i++) histograma[i] = 0;
+	int maximo = tabela_histograma(h, 0, h->sondagem, histograma, classes);
+	if (h->antiga != NULL) {
+		int antiga = tabela_histograma(h->antiga, h->migrados, h->sondagem, histograma, classes);
+		if (antiga > maximo) maximo = antiga;
 	}
-	return false;
+	return maximo;
 }
 
-bool hash_remover_duplo(Hash *h, int chave, TipoElemento **elemento) {
-	if (!hash_ehValida(h) || elemento == NULL) return false;
+int hash_deslocamento_maximo(Hash *h){
+	return hash_histograma_sondagem(h, NULL, 0);
+}
 
-	int h1 = hash_funcao(h, chave);
-	int h2 = hash_funcao_secundaria(h, chave);
+int hash_buscar_lote(Hash *h, const int chaves[], int n, TipoElemento *resultados[]){
+	if (!hash_ehValida(h) || n < 0 || (n > 0 && (chaves == NULL || resultados == NULL))) return -1;
+
+	hash_migrar(h, MIGRACAO_PASSO);
+
+	// Pipeline de prefetch: a origem da chave i + LOTE_BLOCO é calculada e pedida à memória
+	// enquanto a chave i é resolvida, de modo que até LOTE_BLOCO faltas de cache ficam em voo ao
+	// mesmo tempo em vez de acontecerem em série. No modo ponteiro o elemento fica em outra linha,
+	// e um estágio intermediário (na metade da distância) pede o elemento apontado pela origem.
+	uint64_t origens[LOTE_BLOCO];
+	int encontrados = 0;
+	for (int i = 0; i < n + LOTE_BLOCO; i++) {
+		if (i < n) {
+			origens[i % LOTE_BLOCO] = tabela_origem(h, chaves[i]);
+			tabela_prefetch(h, origens[i % LOTE_BLOCO]);
+		}
 
-	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (h1 + i * h2) % h->tamanho;
-		if (h->itens[newPos] == NULL) return false;
-		if (h->itens[newPos]->chave == chave) {
-			*elemento = h->itens[newPos];
-			h->itens[newPos] = NULL;
-			h->qtde--;
-			return true;
+		int meio = i - LOTE_BLOCO / 2;
+		if (h->modo == HASH_PONTEIRO && meio >= 0 && meio < n) {
+			TipoElemento *el = h->itens[origens[meio % LOTE_BLOCO]];
+			if (el != NULL && el != ITEM_REMOVIDO) __builtin_prefetch(el);
+		}
+
+		int j = i - LOTE_BLOCO + 1; // chave resolvida nesta volta
+		if (j < 0 || j >= n) continue;
+		int pos = tabela_localizar_origem(h, chaves[j], origens[j % LOTE_BLOCO], h->sondagem);
+		if (pos >= 0) {
+			resultados[j] = hash_posicao(h, pos);
+		} else if ((pos = hash_localizar_antiga(h, chaves[j], h->sondagem)) >= 0) {
+			resultados[j] = hash_posicao(h->antiga, pos);
+		} else {
+			resultados[j] = NULL;
+			continue;
 		}
+		encontrados++;
 	}
-	return false;
+	return encontrados;
 }
 
-void hash_listar(Hash *h){
-	if (!hash_ehValida(h)) return;
-
-	printf("Elementos armazenados:\n");
-	for (int i = 0; i < h->tamanho; i++) {
-		if (h->itens[i] != NULL) {
-			printf("Pos[%d]: Chave=%d, Dado=%d\n", i, h->itens[i]->chave, h->itens[i]->dado);
-		}
+// Cabeçalho do arquivo da tabela, com os deslocamentos de cada vetor
+static CabecalhoArquivo arquivo_cabecalho(Hash *h){
+	CabecalhoArquivo c;
+	memset(&c, 0, sizeof(c));
+	memcpy(c.magica, ARQUIVO_MAGICA, sizeof(ARQUIVO_MAGICA));
+	c.versao = ARQUIVO_VERSAO;
+	c.ordem = ARQUIVO_ORDEM;
+	c.modo = h->modo;
+	c.funcao = h->funcao;
+	c.sondagem = h->sondagem;
+	c.tamanho = h->tamanho;
+	c.qtde = h->qtde;
+	c.removidos = h->removidos;
+	c.semente = h->semente;
+	c.semente2 = h->semente2;
+
+	uint64_t desloc = (sizeof(CabecalhoArquivo) + LINHA_CACHE - 1) / LINHA_CACHE * LINHA_CACHE;
+	c.desloc_registros = desloc;
+	desloc += sizeof(TipoElemento) * (uint64_t) h->tamanho;
+	c.desloc_controle = desloc;
+	desloc += (uint64_t) h->tamanho;
+	if (h->funcao == HASH_FUNCAO_TABULACAO) {
+		desloc = (desloc + LINHA_CACHE - 1) / LINHA_CACHE * LINHA_CACHE;
+		c.desloc_tabulacao = desloc;
+		desloc += sizeof(uint64_t[TABULACAO_TABELAS][256]);
 	}
+	c.bytes = desloc;
+	return c;
 }
 
-float hash_fator_carga(Hash *h) {
-	if (!hash_ehValida(h) || h->tamanho == 0) return 0.0f;
-	return (float) h->qtde / h->tamanho;
+// Grava bytes a partir de desloc, repetindo as escritas parciais
+static bool arquivo_gravar(int fd, const void *dados, size_t bytes, uint64_t desloc){
+	const char *p = (const char*) dados;
+	while (bytes > 0) {
+		ssize_t n = pwrite(fd, p, bytes, (off_t) desloc);
+		if (n <= 0) return false;
+		p += n;
+		bytes -= (size_t) n;
+		desloc += (uint64_t) n;
+	}
+	return true;
 }
 
-bool hash_redimensionar(Hash *h, int novo_tamanho) {
-	if (!hash_ehValida(h) || novo_tamanho <= h->qtde) return false;
+bool hash_salvar(Hash *h, const char *caminho){
+	if (!hash_ehValida(h) || caminho == NULL || h->modo != HASH_INLINE) return false;
+
+	// O arquivo guarda uma única tabela: sem memória para concluir a migração, nada é gravado
+	hash_migrar(h, INT_MAX);
+	if (h->antiga != NULL) return false;
+	CabecalhoArquivo c = arquivo_cabecalho(h);
+
+	// Grava em um arquivo temporário no mesmo diretório e o renomeia por cima do destino: quem
+	// mapeou a versão anterior continua lendo o arquivo antigo, e quem abrir depois do rename vê a
+	// nova versão completa, nunca um arquivo pela metade
+	size_t tam = strlen(caminho);
+	char *temporario = (char*) malloc(tam + 8);
+	char *diretorio = strdup(caminho);
+	if (temporario == NULL || diretorio == NULL) {
+		free(temporario);
+		free(diretorio);
+		return false;
+	}
+	memcpy(temporario, caminho, tam);
+	memcpy(temporario + tam, ".XXXXXX", 8);
+
+	bool ok = false;
+	int fd = mkstemp(temporario);
+	if (fd >= 0) {
+		ok = arquivo_gravar(fd, &c, sizeof(c), 0)
+			&& arquivo_gravar(fd, h->registros, sizeof(TipoElemento) * h->tamanho, c.desloc_registros)
+			&& arquivo_gravar(fd, h->controle, h->tamanho, c.desloc_controle)
+			&& (c.desloc_tabulacao == 0 || arquivo_gravar(fd, h->tabulacao, sizeof(uint64_t[TABULACAO_TABELAS][256]), c.desloc_tabulacao))
+			&& ftruncate(fd, (off_t) c.bytes) == 0 // completa o preenchimento de alinhamento
+			&& fchmod(fd, 0644) == 0
+			&& fsync(fd) == 0;
+		ok = (close(fd) == 0) && ok;
+		ok = ok && rename(temporario, caminho) == 0;
+		if (!ok) unlink(temporario);
+	}
 
-	// Cria nova tabela com novo tamanho
-	TipoElemento **novos_itens = (TipoElemento **) malloc(sizeof(TipoElemento*) * novo_tamanho);
-	if (novos_itens == NULL) return false;
+	// Persiste a entrada do diretório, para que o rename sobreviva a uma queda de energia
+	if (ok) {
+		int dfd = open(dirname(diretorio), O_RDONLY);
+		if (dfd >= 0) {
+			fsync(dfd);
+			close(dfd);
+		}
+	}
 
-	for (int i = 0; i < novo_tamanho; i++)
-		novos_itens[i] = NULL;
+	free(temporario);
+	free(diretorio);
+	return ok;
+}
 
-	// Reinsere todos os elementos existentes na nova tabela
-	for (int i = 0; i < h->tamanho; i++) {
-		if (h->itens[i] != NULL) {
-			TipoElemento *el = h->itens[i];
-			int nova_pos = el->chave % novo_tamanho;
-
-			// Sondagem linear para reinserção
-			for (int j = 0; j < novo_tamanho; j++) {
-				int pos_tentativa = (nova_pos + j) % novo_tamanho;
-				if (novos_itens[pos_tentativa] == NULL) {
-					novos_itens[pos_tentativa] = el;
-					break;
-				}
-			}
+Hash* hash_abrir_mapeado(const char *caminho){
+	if (caminho == NULL) return NULL;
+
+	int fd = open(caminho, O_RDONLY);
+	if (fd < 0) return NULL;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(CabecalhoArquivo)) {
+		close(fd);
+		return NULL;
+	}
+	size_t bytes = (size_t) st.st_size;
+	void *mapa = mmap(NULL, bytes, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd); // o mapeamento continua válido sem o descritor
+	if (mapa == MAP_FAILED) return NULL;
+
+	// Valida o cabeçalho e recalcula os deslocamentos esperados: os vetores são usados como estão
+	const CabecalhoArquivo *c = (const CabecalhoArquivo*) mapa;
+	Hash *h = NULL;
+	if (memcmp(c->magica, ARQUIVO_MAGICA, sizeof(ARQUIVO_MAGICA)) == 0 && c->versao == ARQUIVO_VERSAO
+		&& c->ordem == ARQUIVO_ORDEM && c->modo == HASH_INLINE && c->funcao <= HASH_FUNCAO_TABULACAO
+		&& c->sondagem <= SONDAGEM_DUPLA && c->tamanho > 0 && c->qtde >= 0 && c->qtde <= c->tamanho
+		&& c->removidos >= 0 && c->removidos <= c->tamanho - c->qtde)
+		h = (Hash*) aligned_alloc(LINHA_CACHE, (sizeof(Hash) + LINHA_CACHE - 1) / LINHA_CACHE * LINHA_CACHE);
+	if (h != NULL) {
+		memset(h, 0, sizeof(Hash));
+		h->modo = HASH_INLINE;
+		h->funcao = (HashFuncao) c->funcao;
+		h->tamanho = c->tamanho;
+		CabecalhoArquivo esperado = arquivo_cabecalho(h);
+		if (c->desloc_registros != esperado.desloc_registros || c->desloc_controle != esperado.desloc_controle
+			|| c->desloc_tabulacao != esperado.desloc_tabulacao || c->bytes != esperado.bytes || c->bytes != bytes) {
+			free(h);
+			h = NULL;
 		}
 	}
+	if (h == NULL) {
+		munmap(mapa, bytes);
+		return NULL;
+	}
+
+	h->qtde = c->qtde;
+	h->removidos = c->removidos;
+	h->limite = c->tamanho;
+	h->sondagem = (Sondagem) c->sondagem;
+	h->politica = hash_politica_padrao();
+	h->tamanho_minimo = c->tamanho;
+	h->semente = c->semente;
+	h->semente2 = c->semente2;
+	h->registros = (TipoElemento*) ((char*) mapa + c->desloc_registros);
+	h->controle = (unsigned char*) mapa + c->desloc_controle;
+	if (c->desloc_tabulacao != 0)
+		h->tabulacao = (uint64_t (*)[256]) ((char*) mapa + c->desloc_tabulacao);
+	h->mapa = mapa;
+	h->mapa_bytes = bytes;
+	return h;
+}
 
-	// Libera tabela antiga e atualiza ponteiro
-	free(h->itens);
-	h->itens = novos_itens;
-	h->tamanho = novo_tamanho;
+Hash* hash_carregar(const char *caminho){
+	Hash *mapeada = hash_abrir_mapeado(caminho);
+	if (mapeada == NULL) return NULL;
 
-	return true;
+	Hash *h = hash_criar_modo(mapeada->tamanho, HASH_INLINE);
+	if (h != NULL && mapeada->funcao == HASH_FUNCAO_TABULACAO) {
+		h->tabulacao = malloc(sizeof(uint64_t[TABULACAO_TABELAS][256]));
+		if (h->tabulacao == NULL) hash_destruir(&h);
+	}
+	if (h != NULL) {
+		memcpy(h->registros, mapeada->registros, sizeof(TipoElemento) * h->tamanho);
+		memcpy(h->controle, mapeada->controle, h->tamanho);
+		if (h->tabulacao != NULL)
+			memcpy(h->tabulacao, mapeada->tabulacao, sizeof(uint64_t[TABULACAO_TABELAS][256]));
+		h->qtde = mapeada->qtde;
+		h->removidos = mapeada->removidos;
+		h->sondagem = mapeada->sondagem;
+		h->funcao = mapeada->funcao;
+		h->semente = mapeada->semente;
+		h->semente2 = mapeada->semente2;
+	}
+	hash_destruir(&mapeada);
+	return h;
 }
 
-int hash_colisoes(Hash *h){
-	if (!hash_ehValida(h)) return -1;
-	return h->colisoes;
-}
\ No newline at end of file
+bool hash_somente_leitura(Hash *h){
+	if (!hash_ehValida(h)) return false;
+	return h->mapa != NULL;
+}
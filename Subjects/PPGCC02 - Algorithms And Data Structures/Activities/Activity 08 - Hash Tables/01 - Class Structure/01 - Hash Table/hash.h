@@ -4,6 +4,7 @@
 #include<stdlib.h>
 #include<stdio.h>
 #include<stdbool.h>
+#include<stdint.h>
 
 struct registro {
   int chave;
@@ -13,7 +14,65 @@ struct registro {
 typedef struct registro TipoElemento;
 typedef struct hash Hash;
 
+// Funções de hash selecionáveis. Todas, menos a divisão, usam a semente aleatória da tabela
+// e reduzem o hash de 32 bits ao intervalo [0, tamanho) com a redução de Lemire
+// ((hash * tamanho) >> 32), que troca a divisão do % por uma multiplicação.
+typedef enum {
+  HASH_FUNCAO_DIVISAO,       // chave % tamanho (padrão)
+  HASH_FUNCAO_MULT_SHIFT,    // multiplicação-deslocamento: bits altos de a*chave + b (a ímpar); 2-universal,
+                             // mas ainda agrupa chaves sequenciais na sondagem linear
+  HASH_FUNCAO_MISTURADOR,    // misturador no estilo wyhash: multiplicação de 128 bits dobrada
+  HASH_FUNCAO_TABULACAO      // tabulação: XOR de 4 tabelas aleatórias indexadas pelos bytes da chave
+} HashFuncao;
+
+// Forma de armazenamento dos elementos na tabela.
+// No modo inline a tabela guarda uma cópia do elemento: o chamador pode reutilizar
+// o que passou para a inserção, e os ponteiros devolvidos por busca e remoção
+// apontam para memória da própria tabela (não devem ser liberados e valem até a
+// próxima alteração da tabela).
+typedef enum {
+  HASH_PONTEIRO, // vetor de ponteiros para elementos alocados pelo chamador (padrão)
+  HASH_INLINE,   // registros {chave, dado} copiados para um vetor contíguo, com byte de controle por posição
+  HASH_SIMD,     // registros inline em grupos de 16 posições sondados com uma comparação SSE2 por grupo
+  HASH_ROBIN_HOOD, // registros inline com sondagem linear Robin Hood: o elemento mais perto da origem cede a posição
+  HASH_CUCKOO     // registros inline em baldes de 4 posições; cada chave só pode estar em um de dois baldes
+} HashModo;
+
+// No modo SIMD o tamanho passado na criação e no redimensionamento é a quantidade máxima
+// de elementos: a tabela aloca posições para mantê-los com carga de até 87,5%, e todas as
+// funções de inserção, busca e remoção usam a mesma sondagem por grupos.
+// No modo Robin Hood todas as funções usam a sondagem linear Robin Hood, cujas buscas sem
+// sucesso param assim que a distância percorrida passa da distância do elemento da posição.
+// No modo cuckoo todas as funções também usam a própria estratégia: uma busca lê no máximo os
+// dois baldes da chave (duas linhas de cache) e um estoque de 4 posições, usado só quando nenhum
+// caminho de despejo acomoda um elemento. O tamanho é arredondado para baldes inteiros mais o
+// estoque, e os baldes são escolhidos por um misturador com a semente da tabela.
+
+// Como escolher o novo tamanho quando a política de carga redimensiona a tabela
+// (o modo SIMD sempre usa potências de 2).
+typedef enum {
+  HASH_PRIMO,     // menor primo maior ou igual ao tamanho desejado (padrão)
+  HASH_POTENCIA_2 // menor potência de 2 maior ou igual ao tamanho desejado
+} HashDimensionamento;
+
+// Política de carga: a tabela cresce (dobrando) antes que uma inserção ultrapasse o limite
+// superior da sondagem usada e encolhe quando uma remoção deixa a carga abaixo do limite
+// inferior, sem ficar menor que o tamanho de criação. Com a política ativa as inserções
+// com sondagem não falham por falta de espaço.
+typedef struct {
+  float crescer_linear;      // padrão 0.7
+  float crescer_quadratica;  // padrão 0.8
+  float crescer_duplo;       // padrão 0.8
+  float crescer_simd;        // padrão 0.875 (máximo do modo SIMD)
+  float crescer_robin_hood;  // padrão 0.9
+  float crescer_cuckoo;      // padrão 0.93
+  float encolher;            // padrão 0.2 (0 desativa o encolhimento)
+  HashDimensionamento dimensionamento;
+} HashPolitica;
+
 Hash* hash_criar(int tamanho);
+Hash* hash_criar_modo(int tamanho, HashModo modo);
+HashModo hash_modo(Hash *h);
 int   hash_tamanho(Hash *ha);
 void  hash_destruir(Hash** enderecoHash);
 bool  hash_inserir(Hash *ha, TipoElemento *elemento);
@@ -26,6 +85,11 @@ bool hash_ehValida(Hash* h);
 int  hash_funcao(Hash* h, int chave);
 int  hash_funcao_secundaria(Hash* h, int chave);
 
+// Troca a função de hash de uma tabela vazia. semente 0 mantém a semente aleatória sorteada na criação.
+// O modo SIMD usa sempre o próprio misturador de 64 bits.
+bool hash_definir_funcao(Hash *h, HashFuncao funcao, uint64_t semente);
+HashFuncao hash_funcao_atual(Hash *h);
+
 bool hash_inserir_linear(Hash *h, TipoElemento *elemento);
 bool hash_inserir_quadratica(Hash *h, TipoElemento *elemento);
 bool hash_inserir_duplo(Hash *h, TipoElemento *elemento);
@@ -34,6 +98,12 @@ bool hash_buscar_linear(Hash *h, int chave, TipoElemento **elemento);
 bool hash_buscar_quadratica(Hash *h, int chave, TipoElemento **elemento);
 bool hash_buscar_duplo(Hash *h, int chave, TipoElemento **elemento);
 
+// Busca as n chaves de uma vez, com a sondagem da última inserção: resultados[i] recebe o
+// elemento de chaves[i] ou NULL. As origens de cada bloco de chaves são calculadas antes e
+// trazidas para a cache com prefetch, sobrepondo as faltas de cache das buscas. Devolve a
+// quantidade de chaves encontradas (-1 se os parâmetros forem inválidos).
+int hash_buscar_lote(Hash *h, const int chaves[], int n, TipoElemento *resultados[]);
+
 bool hash_remover_linear(Hash *h, int chave, TipoElemento **elemento);
 bool hash_remover_quadratica(Hash *h, int chave, TipoElemento **elemento);
 bool hash_remover_duplo(Hash *h, int chave, TipoElemento **elemento);
@@ -41,7 +111,44 @@ bool hash_remover_duplo(Hash *h, int chave, TipoElemento **elemento);
 void hash_listar(Hash *h);
 
 float hash_fator_carga(Hash *h);
+// Reinsere todos os elementos em novo_tamanho posições. Devolve false, sem alterar a tabela, se a
+// sondagem da última inserção não achar posição para algum elemento no novo tamanho.
 bool hash_redimensionar(Hash *h, int novo_tamanho);
+
+// Redimensionamento incremental: aloca a nova tabela e mantém a antiga, migrando um número
+// limitado de posições a cada inserção, busca ou remoção; enquanto a migração não termina,
+// buscas e remoções procuram nas duas tabelas. Os elementos são reinseridos com a sondagem
+// da última inserção, e nos modos inline e SIMD qualquer operação pode mover registros
+// (os ponteiros devolvidos valem só até a próxima operação).
+bool hash_redimensionar_incremental(Hash *h, int novo_tamanho);
+bool hash_redimensionando(Hash *h);
+
+HashPolitica hash_politica_padrao(void);
+bool hash_definir_politica(Hash *h, const HashPolitica *politica); // NULL desativa a política
 int hash_colisoes(Hash *h);
 
+// Posições com marca de remoção. A sondagem linear remove por deslocamento para trás e não
+// deixa marcas; as sondagens quadrática e dupla (e o modo SIMD) deixam marcas, que as buscas
+// atravessam, as inserções reaproveitam e o redimensionamento descarta.
+int hash_removidos(Hash *h);
+
+// Distribuição das distâncias de sondagem (passos entre a posição de origem de cada elemento e a
+// posição em que ele está; no modo SIMD, passos entre grupos), segundo a sondagem da última
+// inserção. histograma[d] recebe a quantidade de elementos a distância d, e a última classe
+// acumula as distâncias maiores. Devolve o deslocamento máximo, que limita o custo das buscas.
+int hash_histograma_sondagem(Hash *h, int histograma[], int classes);
+int hash_deslocamento_maximo(Hash *h);
+
+// Persistência da tabela inline em arquivo: cabeçalho (tamanho, quantidade, função de hash,
+// sementes e sondagem) seguido do vetor de registros e dos bytes de controle, como estão na memória.
+// hash_salvar conclui um redimensionamento incremental em andamento, grava um arquivo temporário
+// e o renomeia por cima de caminho (substituição atômica). hash_abrir_mapeado mapeia o arquivo
+// com mmap, sem desserializar nada: as buscas leem direto do mapeamento, e inserções, remoções e
+// redimensionamentos falham. Para alterar a tabela, hash_carregar faz uma cópia modificável, que
+// depois é salva por cima do arquivo; quem já mapeou a versão anterior continua lendo a anterior.
+bool hash_salvar(Hash *h, const char *caminho);
+Hash* hash_abrir_mapeado(const char *caminho);
+Hash* hash_carregar(const char *caminho);
+bool hash_somente_leitura(Hash *h);
+
 #endif
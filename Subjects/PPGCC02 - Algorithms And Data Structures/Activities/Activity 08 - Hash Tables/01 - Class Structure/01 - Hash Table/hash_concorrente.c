@@ -0,0 +1,158 @@
+#include "hash_concorrente.h"
+#include <pthread.h>
+#include <stdint.h>
+
+#define LINHA_CACHE 64
+
+/**************************************
+* DADOS
+**************************************/
+
+// Cada partição ocupa linhas de cache próprias: a trava e os contadores de uma partição
+// não invalidam a linha de outra quando threads diferentes as alteram (falso compartilhamento)
+typedef struct {
+  pthread_mutex_t trava;
+  Hash *tabela;
+  int qtde;      // elementos da partição, lido sem trava por hash_concorrente_tamanho
+  int colisoes;
+} __attribute__((aligned(LINHA_CACHE))) Particao;
+
+struct hash_concorrente{
+  Particao *particoes;
+  int quantidade;  // potência de 2
+  int deslocamento; // bits descartados do hash da chave para escolher a partição
+};
+
+
+/**************************************
+* FUNÇÕES AUXILIARES
+**************************************/
+
+// Partição da chave pelos bits altos de um misturador (finalizador do MurmurHash3). A tabela
+// de cada partição espalha as chaves com a própria função de hash; usar bits independentes
+// evita que todas as chaves de uma partição caiam na mesma fração das suas posições.
+static Particao* hash_concorrente_particao(HashConcorrente *hc, int chave){
+	uint64_t x = (uint32_t) chave;
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return &hc->particoes[hc->deslocamento < 64 ? x >> hc->deslocamento : 0];
+}
+
+// Atualiza os contadores da partição (chamada com a trava tomada)
+static void hash_concorrente_contar(Particao *p){
+	__atomic_store_n(&p->qtde, hash_tamanho(p->tabela), __ATOMIC_RELAXED);
+	__atomic_store_n(&p->colisoes, hash_colisoes(p->tabela), __ATOMIC_RELAXED);
+}
+
+
+/**************************************
+* IMPLEMENTAÇÃO
+**************************************/
+
+HashConcorrente* hash_concorrente_criar(int particoes, int tamanho, HashModo modo){
+	if (particoes <= 0 || particoes > (1 << 20) || tamanho <= 0) return NULL;
+
+	HashConcorrente *hc = (HashConcorrente*) malloc(sizeof(HashConcorrente));
+	if (hc == NULL) return NULL;
+
+	int bits = 0;
+	while ((1 << bits) < particoes) bits++;
+	hc->quantidade = 1 << bits;
+	hc->deslocamento = 64 - bits;
+	hc->particoes = (Particao*) aligned_alloc(LINHA_CACHE, sizeof(Particao) * hc->quantidade);
+	if (hc->particoes == NULL) {
+		free(hc);
+		return NULL;
+	}
+
+	HashPolitica politica = hash_politica_padrao();
+	for (int i = 0; i < hc->quantidade; i++) {
+		Particao *p = &hc->particoes[i];
+		p->tabela = hash_criar_modo(tamanho, modo);
+		if (p->tabela == NULL || !hash_definir_politica(p->tabela, &politica)) {
+			hash_destruir(&p->tabela);
+			hc->quantidade = i; // destrói só as partições já criadas
+			hash_concorrente_destruir(&hc);
+			return NULL;
+		}
+		pthread_mutex_init(&p->trava, NULL);
+		p->qtde = 0;
+		p->colisoes = 0;
+	}
+
+	return hc;
+}
+
+void hash_concorrente_destruir(HashConcorrente **enderecoHash){
+	if (enderecoHash == NULL || *enderecoHash == NULL) return;
+
+	HashConcorrente *hc = *enderecoHash;
+	for (int i = 0; i < hc->quantidade; i++) {
+		pthread_mutex_destroy(&hc->particoes[i].trava);
+		hash_destruir(&hc->particoes[i].tabela);
+	}
+	free(hc->particoes);
+	free(hc);
+	*enderecoHash = NULL;
+}
+
+bool hash_concorrente_inserir(HashConcorrente *hc, TipoElemento *elemento){
+	if (hc == NULL || elemento == NULL) return false;
+
+	Particao *p = hash_concorrente_particao(hc, elemento->chave);
+	pthread_mutex_lock(&p->trava);
+	bool ok = hash_inserir_linear(p->tabela, elemento);
+	hash_concorrente_contar(p);
+	pthread_mutex_unlock(&p->trava);
+	return ok;
+}
+
+bool hash_concorrente_buscar(HashConcorrente *hc, int chave, TipoElemento *elemento){
+	if (hc == NULL || elemento == NULL) return false;
+
+	Particao *p = hash_concorrente_particao(hc, chave);
+	TipoElemento *encontrado;
+	pthread_mutex_lock(&p->trava);
+	bool ok = hash_buscar_linear(p->tabela, chave, &encontrado);
+	if (ok) *elemento = *encontrado;
+	pthread_mutex_unlock(&p->trava);
+	return ok;
+}
+
+bool hash_concorrente_remover(HashConcorrente *hc, int chave, TipoElemento *elemento){
+	if (hc == NULL || elemento == NULL) return false;
+
+	Particao *p = hash_concorrente_particao(hc, chave);
+	TipoElemento *removido;
+	pthread_mutex_lock(&p->trava);
+	bool ok = hash_remover_linear(p->tabela, chave, &removido);
+	if (ok) *elemento = *removido;
+	hash_concorrente_contar(p);
+	pthread_mutex_unlock(&p->trava);
+	return ok;
+}
+
+int hash_concorrente_particoes(HashConcorrente *hc){
+	if (hc == NULL) return -1;
+	return hc->quantidade;
+}
+
+// Soma os contadores sem tomar as travas: com inserções em andamento o total é aproximado
+int hash_concorrente_tamanho(HashConcorrente *hc){
+	if (hc == NULL) return -1;
+	int total = 0;
+	for (int i = 0; i < hc->quantidade; i++)
+		total += __atomic_load_n(&hc->particoes[i].qtde, __ATOMIC_RELAXED);
+	return total;
+}
+
+int hash_concorrente_colisoes(HashConcorrente *hc){
+	if (hc == NULL) return -1;
+	int total = 0;
+	for (int i = 0; i < hc->quantidade; i++)
+		total += __atomic_load_n(&hc->particoes[i].colisoes, __ATOMIC_RELAXED);
+	return total;
+}
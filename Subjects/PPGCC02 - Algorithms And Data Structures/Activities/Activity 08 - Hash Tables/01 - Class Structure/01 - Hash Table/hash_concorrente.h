@@ -0,0 +1,30 @@
+#ifndef _HASH_CONCORRENTE_H_
+#define _HASH_CONCORRENTE_H_
+
+#include "hash.h"
+
+// Tabela hash que pode ser compartilhada entre threads. As chaves são repartidas entre
+// partições (uma potência de 2), cada uma com uma tabela Hash independente, sua própria
+// trava e sua própria política de carga: threads que acessam partições diferentes não
+// disputam trava nenhuma, e o redimensionamento de uma partição não bloqueia as outras.
+// As buscas também tomam a trava, pois uma busca pode migrar posições de uma partição que
+// está sendo redimensionada incrementalmente.
+typedef struct hash_concorrente HashConcorrente;
+
+// particoes é arredondado para a potência de 2 seguinte; tamanho é o tamanho inicial de cada
+// partição. No modo ponteiro os elementos inseridos continuam sendo do chamador.
+HashConcorrente* hash_concorrente_criar(int particoes, int tamanho, HashModo modo);
+void hash_concorrente_destruir(HashConcorrente **enderecoHash);
+
+// Inserção, busca e remoção com sondagem linear (os modos SIMD, Robin Hood e cuckoo usam a própria).
+// Busca e remoção copiam o elemento para *elemento, já que a posição pode mudar assim que a
+// trava da partição é liberada.
+bool hash_concorrente_inserir(HashConcorrente *hc, TipoElemento *elemento);
+bool hash_concorrente_buscar(HashConcorrente *hc, int chave, TipoElemento *elemento);
+bool hash_concorrente_remover(HashConcorrente *hc, int chave, TipoElemento *elemento);
+
+int hash_concorrente_particoes(HashConcorrente *hc);
+int hash_concorrente_tamanho(HashConcorrente *hc);
+int hash_concorrente_colisoes(HashConcorrente *hc);
+
+#endif
@@ -141,6 +141,210 @@ void teste_remover_linear(Hash *h, int chave) {
 	}
 }
 
+// Insere, busca e remove com sondagem linear nos modos inline e SIMD (sem malloc por elemento)
+void teste_inserir_inline(int tamanho, HashModo modo) {
+	printf("Teste inserção COM sondagem LINEAR no modo %s\n", modo == HASH_SIMD ? "SIMD" : "INLINE");
+	Hash *h = hash_criar_modo(tamanho, modo);
+	if (!h) {
+		printf("Falha ao criar hash\n");
+		return;
+	}
+
+	int i = 0;
+	TipoElemento el; // a tabela copia o registro, então o mesmo elemento é reutilizado
+	while (!hash_cheio(h)) {
+		el.chave = randomInteger(0, tamanho * 2);
+		el.dado = el.chave * 10;
+
+		TipoElemento *existente;
+		if (!hash_buscar_linear(h, el.chave, &existente) && hash_inserir_linear(h, &el)) {
+			i++;
+		}
+	}
+
+	printf("Inseridos %d elementos\n", i);
+	hash_imprimir(h);
+	printf("Colisões ocorridas: %d\n", hash_colisoes(h));
+
+	int chave = randomInteger(0, tamanho * 2);
+	TipoElemento *res = NULL;
+	teste_buscar_linear(h, chave);
+	if (hash_remover_linear(h, chave, &res)) { // res aponta para a tabela: não é liberado
+		printf("Removido chave %d com dado %d\n", chave, res->dado);
+	} else {
+		printf("Falha ao remover chave %d\n", chave);
+	}
+	teste_buscar_linear(h, chave);
+
+	hash_destruir(&h);
+}
+
+// Insere 10 vezes a capacidade inicial com a política de carga ativa e depois remove 90% dos elementos
+void teste_politica_carga(int tamanho) {
+	printf("Teste política de carga (crescimento e encolhimento automáticos) no modo INLINE\n");
+	Hash *h = hash_criar_modo(tamanho, HASH_INLINE);
+	HashPolitica politica = hash_politica_padrao();
+	if (!h || !hash_definir_politica(h, &politica)) {
+		printf("Falha ao criar hash\n");
+		return;
+	}
+
+	int total = tamanho * 10;
+	TipoElemento el;
+	for (int i = 0; i < total; i++) {
+		el.chave = i;
+		el.dado = i * 10;
+		if (!hash_inserir_linear(h, &el)) printf("Falha inserindo chave %d\n", i);
+	}
+	printf("Inseridos %d elementos, fator de carga %.2f\n", hash_tamanho(h), hash_fator_carga(h));
+
+	TipoElemento *res;
+	for (int i = 0; i < total; i++) {
+		if (i % 10 != 0 && !hash_remover_linear(h, i, &res)) printf("Falha ao remover chave %d\n", i);
+	}
+	printf("Restaram %d elementos, fator de carga %.2f\n", hash_tamanho(h), hash_fator_carga(h));
+	teste_buscar_linear(h, 0);
+	teste_buscar_linear(h, 1);
+
+	hash_destruir(&h);
+}
+
+// Duplo hashing com a função da divisão em tabelas inline cujo tamanho a política mantém em
+// potências de 2: cria 300 tabelas de tamanho posições, insere 4 vezes esse número de chaves
+// aleatórias em cada uma e confere que nenhuma inserção falhou e que todas as chaves são achadas
+void teste_politica_potencia_2(int tamanho) {
+	printf("Teste política de carga com potências de 2 e duplo hashing no modo INLINE\n");
+	HashPolitica politica = hash_politica_padrao();
+	politica.dimensionamento = HASH_POTENCIA_2;
+
+	int falhas = 0, perdidas = 0, inseridas = 0;
+	int *chaves = (int*) malloc(sizeof(int) * tamanho * 4);
+	for (int t = 0; t < 300 && chaves != NULL; t++) {
+		Hash *h = hash_criar_modo(tamanho, HASH_INLINE);
+		if (!h || !hash_definir_politica(h, &politica)) {
+			printf("Falha ao criar hash\n");
+			hash_destruir(&h);
+			break;
+		}
+
+		TipoElemento el, *res;
+		int n = 0;
+		for (int i = 0; i < tamanho * 4; i++) {
+			el.chave = randomInteger(0, 1000000);
+			el.dado = el.chave * 10;
+			if (hash_buscar_duplo(h, el.chave, &res)) continue;
+			if (hash_inserir_duplo(h, &el)) chaves[n++] = el.chave;
+			else falhas++;
+		}
+		for (int i = 0; i < n; i++)
+			perdidas += !hash_buscar_duplo(h, chaves[i], &res) || res->dado != chaves[i] * 10;
+		inseridas += n;
+		hash_destruir(&h);
+	}
+	free(chaves);
+	printf("%d chaves inseridas, %d inserções falharam, %d chaves não encontradas\n", inseridas, falhas, perdidas);
+}
+
+// Imprime o histograma de distâncias de sondagem e o deslocamento máximo da tabela
+void imprimir_histograma(Hash *h) {
+	int histograma[16];
+	int maximo = hash_histograma_sondagem(h, histograma, 16);
+	for (int d = 0; d < 16; d++) {
+		if (histograma[d] > 0) printf("  distância %s%2d: %d\n", d == 15 ? ">=" : "  ", d, histograma[d]);
+	}
+	printf("  deslocamento máximo: %d\n", maximo);
+}
+
+// Carrega a 90% uma tabela inline com sondagem linear e outra Robin Hood com as mesmas chaves
+// e compara as distribuições das distâncias de sondagem
+void teste_robin_hood(int tamanho) {
+	printf("Teste Robin Hood: distâncias de sondagem com carga de 90%%\n");
+	Hash *linear = hash_criar_modo(tamanho, HASH_INLINE);
+	Hash *robin_hood = hash_criar_modo(tamanho, HASH_ROBIN_HOOD);
+	if (!linear || !robin_hood) {
+		printf("Falha ao criar hash\n");
+		hash_destruir(&linear);
+		hash_destruir(&robin_hood);
+		return;
+	}
+	hash_definir_funcao(linear, HASH_FUNCAO_MISTURADOR, 42);
+	hash_definir_funcao(robin_hood, HASH_FUNCAO_MISTURADOR, 42);
+
+	TipoElemento el, *existente;
+	while (hash_fator_carga(robin_hood) < 0.9f) {
+		el.chave = randomInteger(0, tamanho * 10);
+		el.dado = el.chave * 10;
+		if (!hash_buscar_linear(robin_hood, el.chave, &existente)) {
+			hash_inserir_linear(linear, &el);
+			hash_inserir_linear(robin_hood, &el);
+		}
+	}
+
+	printf("Sondagem linear (%d elementos):\n", hash_tamanho(linear));
+	imprimir_histograma(linear);
+	printf("Robin Hood (%d elementos):\n", hash_tamanho(robin_hood));
+	imprimir_histograma(robin_hood);
+
+	hash_destruir(&linear);
+	hash_destruir(&robin_hood);
+}
+
+// Conta quantas das chaves 0..n-1 a tabela encontra
+int contar_chaves(Hash *h, int n) {
+	TipoElemento *res;
+	int encontradas = 0;
+	for (int i = 0; i < n; i++)
+		encontradas += hash_buscar_linear(h, i, &res) && res->dado == i * 10;
+	return encontradas;
+}
+
+// Salva uma tabela inline em arquivo, abre o arquivo mapeado (somente leitura) e atualiza o
+// arquivo com substituição atômica enquanto o mapeamento anterior continua aberto
+void teste_arquivo(int tamanho) {
+	const char *caminho = "hash.dat";
+	printf("Teste arquivo mapeado: tabela inline com %d elementos em %s\n", tamanho, caminho);
+	Hash *h = hash_criar_modo(tamanho, HASH_INLINE);
+	HashPolitica politica = hash_politica_padrao();
+	if (!h || !hash_definir_funcao(h, HASH_FUNCAO_MISTURADOR, 0) || !hash_definir_politica(h, &politica)) {
+		printf("Falha ao criar hash\n");
+		hash_destruir(&h);
+		return;
+	}
+
+	TipoElemento el;
+	for (int i = 0; i < tamanho; i++) {
+		el.chave = i;
+		el.dado = i * 10;
+		hash_inserir_linear(h, &el);
+	}
+	printf("Salvar: %s\n", hash_salvar(h, caminho) ? "OK" : "falhou");
+	hash_destruir(&h);
+
+	Hash *leitura = hash_abrir_mapeado(caminho);
+	if (!leitura) {
+		printf("Falha ao abrir %s\n", caminho);
+		return;
+	}
+	printf("Mapeada: %d elementos, %d encontrados, somente leitura: %s\n", hash_tamanho(leitura),
+		contar_chaves(leitura, tamanho), hash_somente_leitura(leitura) ? "Sim" : "Não");
+	el.chave = tamanho;
+	el.dado = tamanho * 10;
+	printf("Inserção na tabela mapeada: %s\n", hash_inserir_linear(leitura, &el) ? "aceita" : "recusada");
+
+	// Escritor: cópia modificável, uma chave a mais, e substituição do arquivo
+	Hash *escrita = hash_carregar(caminho);
+	if (escrita && hash_inserir_linear(escrita, &el) && hash_salvar(escrita, caminho))
+		printf("Arquivo atualizado com %d elementos\n", hash_tamanho(escrita));
+	hash_destruir(&escrita);
+
+	Hash *nova = hash_abrir_mapeado(caminho);
+	printf("Mapeamento anterior encontra %d chaves; reaberto encontra %d\n",
+		contar_chaves(leitura, tamanho + 1), nova ? contar_chaves(nova, tamanho + 1) : -1);
+	hash_destruir(&leitura);
+	hash_destruir(&nova);
+	remove(caminho);
+}
+
 int main(int argc, char *argv[]) {
 	if (argc < 3) {
 		printf("Uso: %s <tamanho_hash> <tipo_teste>\n", argv[0]);
@@ -149,6 +353,12 @@ int main(int argc, char *argv[]) {
 		printf("  1 - inserção sondagem linear\n");
 		printf("  2 - inserção sondagem quadrática\n");
 		printf("  3 - inserção duplo hashing\n");
+		printf("  4 - inserção sondagem linear no modo inline\n");
+		printf("  5 - inserção no modo SIMD (grupos de 16 posições)\n");
+		printf("  6 - política de carga com redimensionamento automático\n");
+		printf("  7 - histograma de sondagem: linear x Robin Hood\n");
+		printf("  8 - arquivo mapeado com substituição atômica\n");
+		printf("  9 - política de carga com potências de 2 e duplo hashing\n");
 		return 1;
 	}
 
@@ -170,6 +380,24 @@ int main(int argc, char *argv[]) {
 		case 3:
 			teste_inserir_duplo(tamanho);
 			break;
+		case 4:
+			teste_inserir_inline(tamanho, HASH_INLINE);
+			break;
+		case 5:
+			teste_inserir_inline(tamanho, HASH_SIMD);
+			break;
+		case 6:
+			teste_politica_carga(tamanho);
+			break;
+		case 7:
+			teste_robin_hood(tamanho);
+			break;
+		case 8:
+			teste_arquivo(tamanho);
+			break;
+		case 9:
+			teste_politica_potencia_2(tamanho);
+			break;
 		default:
 			printf("Tipo de teste inválido\n");
 			return 1;
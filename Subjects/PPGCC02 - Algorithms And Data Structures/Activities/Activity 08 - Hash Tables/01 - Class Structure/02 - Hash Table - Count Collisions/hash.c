@@ -1,6 +1,8 @@
 #include "hash.h"
+#include <time.h>
 
 #define TAM_INICIAL 100000
+#define TABULACAO_TABELAS 4 // um int tem 4 bytes
 
 /**************************************
 * DADOS
@@ -10,6 +12,10 @@ struct hash{
   int qtde, tamanho;
   TipoElemento **itens;
   int colisoes; // novo campo para contagem de colisões
+  HashFuncao funcao;
+  uint64_t semente;  // sorteada por tabela; multiplicador e deslocamento da multiplicação-deslocamento
+  uint64_t semente2;
+  uint64_t (*tabulacao)[256]; // tabelas aleatórias da tabulação (só alocadas quando ela é escolhida)
 };
 
 /**************************************
@@ -20,8 +26,59 @@ bool hash_ehValida(Hash* h){
 	return (h != NULL? true: false);
 }
 
+// Gerador splitmix64: expande uma semente em valores pseudoaleatórios independentes
+static uint64_t splitmix64(uint64_t *estado){
+	uint64_t z = (*estado += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// Semente diferente para cada tabela criada, mesmo dentro do mesmo segundo
+static uint64_t hash_semente_aleatoria(void){
+	static uint64_t contador = 0;
+	uint64_t estado = (uint64_t) time(NULL) ^ ((uint64_t) (uintptr_t) &contador << 16) ^ (++contador << 40);
+	return splitmix64(&estado);
+}
+
+// Multiplicação de 128 bits dobrada em 64 (a operação básica do wyhash)
+static uint64_t hash_mum(uint64_t a, uint64_t b){
+	__uint128_t r = (__uint128_t) a * b;
+	return (uint64_t) r ^ (uint64_t) (r >> 64);
+}
+
+// Hash de 64 bits da chave. Na multiplicação-deslocamento só os 32 bits altos são bons;
+// nas outras funções as duas metades são independentes.
+static uint64_t hash_calcular(Hash *h, int chave){
+	uint64_t x = (uint32_t) chave;
+	switch (h->funcao) {
+		case HASH_FUNCAO_MULT_SHIFT:
+			return (h->semente | 1) * x + h->semente2;
+		case HASH_FUNCAO_MISTURADOR: {
+			// Caminho do wyhash para entradas de 4 bytes
+			uint64_t y = x << 32 | x;
+			__uint128_t m = (__uint128_t) (y ^ 0xe7037ed1a0b428dbULL) * (y ^ h->semente);
+			return hash_mum((uint64_t) m ^ 0xa0761d6478bd642fULL ^ 4, (uint64_t) (m >> 64) ^ 0xe7037ed1a0b428dbULL);
+		}
+		case HASH_FUNCAO_TABULACAO: {
+			uint64_t r = 0;
+			for (int i = 0; i < TABULACAO_TABELAS; i++)
+				r ^= h->tabulacao[i][(x >> (8 * i)) & 0xFF];
+			return r;
+		}
+		default:
+			return x;
+	}
+}
+
+// Redução de Lemire: leva x de 32 bits ao intervalo [0, n) sem divisão
+static int hash_reduzir(uint32_t x, int n){
+	return (int) (((uint64_t) x * (uint32_t) n) >> 32);
+}
+
 int hash_funcao(Hash* h, int chave){
-	return chave % h->tamanho;
+	if (h->funcao == HASH_FUNCAO_DIVISAO) return chave % h->tamanho;
+	return hash_reduzir((uint32_t) (hash_calcular(h, chave) >> 32), h->tamanho);
 }
 
 
@@ -48,6 +105,10 @@ Hash* hash_criar(int tamanho){
 	h->qtde = 0;
 	h->tamanho = tamanho;
 	h->colisoes = 0;  // inicializa contagem
+	h->funcao = HASH_FUNCAO_DIVISAO;
+	h->semente = hash_semente_aleatoria();
+	h->semente2 = hash_semente_aleatoria();
+	h->tabulacao = NULL;
 
 	return h;
 }
@@ -58,6 +119,7 @@ void  hash_destruir(Hash** enderecoHash){
 
 	Hash *h = *enderecoHash;
 	free(h->itens);
+	free(h->tabulacao);
 	free(h);
 	*enderecoHash = NULL;
 }
@@ -149,7 +211,7 @@ bool hash_inserir_quadratica(Hash *h, TipoElemento *elemento){
 
 	int pos = hash_funcao(h, elemento->chave);
 	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (pos + i*i) % h->tamanho;
+		int newPos = (pos + (long long) i*i) % h->tamanho; // i*i estoura int em tabelas grandes
 		if (h->itens[newPos] == NULL) {
 			h->itens[newPos] = elemento;
 			h->qtde++;
@@ -165,7 +227,44 @@ bool hash_inserir_quadratica(Hash *h, TipoElemento *elemento){
 
 int hash_funcao_secundaria(Hash* h, int chave) {
 	if (!hash_ehValida(h)) return 1;
-	return 1 + (chave % (h->tamanho - 1));
+	if (h->funcao == HASH_FUNCAO_DIVISAO) return 1 + (chave % (h->tamanho - 1));
+
+	// Passo independente da posição inicial: a metade baixa do hash ou, na multiplicação-deslocamento
+	// (cujos bits baixos são fracos), uma segunda multiplicação com os papéis das sementes trocados
+	uint32_t x;
+	if (h->funcao == HASH_FUNCAO_MULT_SHIFT)
+		x = (uint32_t) (((h->semente2 | 1) * (uint64_t) (uint32_t) chave + h->semente) >> 32);
+	else
+		x = (uint32_t) hash_calcular(h, chave);
+	int passo = 1 + hash_reduzir(x, h->tamanho - 1);
+	if ((h->tamanho & (h->tamanho - 1)) == 0) passo |= 1; // em potências de 2 só passos ímpares visitam todas as posições
+	return passo;
+}
+
+bool hash_definir_funcao(Hash *h, HashFuncao funcao, uint64_t semente) {
+	if (!hash_ehValida(h) || h->qtde > 0) return false; // as posições dependem da função
+
+	if (semente != 0) {
+		h->semente = splitmix64(&semente);
+		h->semente2 = splitmix64(&semente);
+	}
+	if (funcao == HASH_FUNCAO_TABULACAO) {
+		if (h->tabulacao == NULL) {
+			h->tabulacao = malloc(sizeof(uint64_t[TABULACAO_TABELAS][256]));
+			if (h->tabulacao == NULL) return false;
+		}
+		uint64_t estado = h->semente ^ h->semente2;
+		for (int i = 0; i < TABULACAO_TABELAS; i++)
+			for (int j = 0; j < 256; j++)
+				h->tabulacao[i][j] = splitmix64(&estado);
+	}
+	h->funcao = funcao;
+	return true;
+}
+
+HashFuncao hash_funcao_atual(Hash *h) {
+	if (!hash_ehValida(h)) return HASH_FUNCAO_DIVISAO;
+	return h->funcao;
 }
 
 bool hash_inserir_duplo(Hash *h, TipoElemento *elemento){
@@ -175,7 +274,7 @@ bool hash_inserir_duplo(Hash *h, TipoElemento *elemento){
 	int h2 = hash_funcao_secundaria(h, elemento->chave);
 
 	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (h1 + i * h2) % h->tamanho;
+		int newPos = (h1 + (long long) i * h2) % h->tamanho;
 		if (h->itens[newPos] == NULL) {
 			h->itens[newPos] = elemento;
 			h->qtde++;
@@ -209,7 +308,7 @@ bool hash_buscar_quadratica(Hash *h, int chave, TipoElemento **elemento) {
 
 	int pos = hash_funcao(h, chave);
 	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (pos + i*i) % h->tamanho;
+		int newPos = (pos + (long long) i*i) % h->tamanho; // i*i estoura int em tabelas grandes
 		if (h->itens[newPos] == NULL) return false;
 		if (h->itens[newPos]->chave == chave) {
 			*elemento = h->itens[newPos];
@@ -226,7 +325,7 @@ bool hash_buscar_duplo(Hash *h, int chave, TipoElemento **elemento) {
 	int h2 = hash_funcao_secundaria(h, chave);
 
 	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (h1 + i * h2) % h->tamanho;
+		int newPos = (h1 + (long long) i * h2) % h->tamanho;
 		if (h->itens[newPos] == NULL) return false;
 		if (h->itens[newPos]->chave == chave) {
 			*elemento = h->itens[newPos];
@@ -258,7 +357,7 @@ bool hash_remover_quadratica(Hash *h, int chave, TipoElemento **elemento) {
 
 	int pos = hash_funcao(h, chave);
 	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (pos + i*i) % h->tamanho;
+		int newPos = (pos + (long long) i*i) % h->tamanho; // i*i estoura int em tabelas grandes
 		if (h->itens[newPos] == NULL) return false;
 		if (h->itens[newPos]->chave == chave) {
 			*elemento = h->itens[newPos];
@@ -277,7 +376,7 @@ bool hash_remover_duplo(Hash *h, int chave, TipoElemento **elemento) {
 	int h2 = hash_funcao_secundaria(h, chave);
 
 	for (int i = 0; i < h->tamanho; i++) {
-		int newPos = (h1 + i * h2) % h->tamanho;
+		int newPos = (h1 + (long long) i * h2) % h->tamanho;
 		if (h->itens[newPos] == NULL) return false;
 		if (h->itens[newPos]->chave == chave) {
 			*elemento = h->itens[newPos];
@@ -316,10 +415,12 @@ bool hash_redimensionar(Hash *h, int novo_tamanho) {
 		novos_itens[i] = NULL;
 
 	// Reinsere todos os elementos existentes na nova tabela
-	for (int i = 0; i < h->tamanho; i++) {
+	int tamanho_antigo = h->tamanho;
+	h->tamanho = novo_tamanho; // hash_funcao passa a reduzir para o novo tamanho
+	for (int i = 0; i < tamanho_antigo; i++) {
 		if (h->itens[i] != NULL) {
 			TipoElemento *el = h->itens[i];
-			int nova_pos = el->chave % novo_tamanho;
+			int nova_pos = hash_funcao(h, el->chave);
 
 			// Sondagem linear para reinserção
 			for (int j = 0; j < novo_tamanho; j++) {
@@ -335,7 +436,6 @@ bool hash_redimensionar(Hash *h, int novo_tamanho) {
 	// Libera tabela antiga e atualiza ponteiro
 	free(h->itens);
 	h->itens = novos_itens;
-	h->tamanho = novo_tamanho;
 
 	return true;
 }
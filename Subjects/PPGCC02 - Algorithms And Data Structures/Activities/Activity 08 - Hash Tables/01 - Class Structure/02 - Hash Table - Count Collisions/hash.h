@@ -4,6 +4,7 @@
 #include<stdlib.h>
 #include<stdio.h>
 #include<stdbool.h>
+#include<stdint.h>
 
 struct registro {
   int chave;
@@ -13,6 +14,17 @@ struct registro {
 typedef struct registro TipoElemento;
 typedef struct hash Hash;
 
+// Funções de hash selecionáveis. Todas, menos a divisão, usam a semente aleatória da tabela
+// e reduzem o hash de 32 bits ao intervalo [0, tamanho) com a redução de Lemire
+// ((hash * tamanho) >> 32), que troca a divisão do % por uma multiplicação.
+typedef enum {
+  HASH_FUNCAO_DIVISAO,       // chave % tamanho (padrão)
+  HASH_FUNCAO_MULT_SHIFT,    // multiplicação-deslocamento: bits altos de a*chave + b (a ímpar); 2-universal,
+                             // mas ainda agrupa chaves sequenciais na sondagem linear
+  HASH_FUNCAO_MISTURADOR,    // misturador no estilo wyhash: multiplicação de 128 bits dobrada
+  HASH_FUNCAO_TABULACAO      // tabulação: XOR de 4 tabelas aleatórias indexadas pelos bytes da chave
+} HashFuncao;
+
 Hash* hash_criar(int tamanho);
 int   hash_tamanho(Hash *ha);
 void  hash_destruir(Hash** enderecoHash);
@@ -26,6 +38,10 @@ bool hash_ehValida(Hash* h);
 int  hash_funcao(Hash* h, int chave);
 int  hash_funcao_secundaria(Hash* h, int chave);
 
+// Troca a função de hash de uma tabela vazia. semente 0 mantém a semente aleatória sorteada na criação.
+bool hash_definir_funcao(Hash *h, HashFuncao funcao, uint64_t semente);
+HashFuncao hash_funcao_atual(Hash *h);
+
 bool hash_inserir_linear(Hash *h, TipoElemento *elemento);
 bool hash_inserir_quadratica(Hash *h, TipoElemento *elemento);
 bool hash_inserir_duplo(Hash *h, TipoElemento *elemento);
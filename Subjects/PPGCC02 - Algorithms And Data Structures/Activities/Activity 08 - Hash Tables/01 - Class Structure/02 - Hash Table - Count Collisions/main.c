@@ -137,6 +137,48 @@ void teste_remover_linear(Hash *h, int chave) {
 	}
 }
 
+// Conta as colisões de cada função de hash com 75% de carga, para chaves sequenciais,
+// chaves com passo comum (múltiplos de 64) e chaves aleatórias
+void teste_funcoes_hash(int tamanho) {
+	const char *funcoes[] = { "divisao", "mult_shift", "misturador", "tabulacao" };
+	const char *padroes[] = { "sequencial", "passo 64", "aleatorio" };
+	bool (*inserir[])(Hash*, TipoElemento*) = { hash_inserir_linear, hash_inserir_quadratica, hash_inserir_duplo };
+	int n = tamanho * 3 / 4;
+
+	TipoElemento *elementos = (TipoElemento*) malloc(sizeof(TipoElemento) * n);
+	if (!elementos) {
+		printf("Falha ao alocar elementos\n");
+		return;
+	}
+
+	printf("Colisões com %d chaves em tabela de tamanho %d (linear / quadrática / duplo)\n", n, tamanho);
+	printf("%-12s", "funcao");
+	for (int p = 0; p < 3; p++) printf(" | %-26s", padroes[p]);
+	printf("\n");
+
+	for (int f = HASH_FUNCAO_DIVISAO; f <= HASH_FUNCAO_TABULACAO; f++) {
+		printf("%-12s", funcoes[f]);
+		for (int p = 0; p < 3; p++) {
+			for (int i = 0; i < n; i++) {
+				elementos[i].chave = p == 0 ? i : p == 1 ? i * 64 : randomInteger(0, 1 << 30);
+				elementos[i].dado = i;
+			}
+			printf(" |");
+			for (int s = 0; s < 3; s++) {
+				Hash *h = hash_criar(tamanho);
+				hash_definir_funcao(h, (HashFuncao) f, 0);
+				for (int i = 0; i < n; i++)
+					inserir[s](h, &elementos[i]);
+				printf(" %8d", hash_colisoes(h));
+				hash_destruir(&h);
+			}
+		}
+		printf("\n");
+	}
+
+	free(elementos);
+}
+
 int main(int argc, char *argv[]) {
 	if (argc < 3) {
 		printf("Uso: %s <tamanho_hash> <tipo_teste>\n", argv[0]);
@@ -145,6 +187,7 @@ int main(int argc, char *argv[]) {
 		printf("  1 - inserção sondagem linear\n");
 		printf("  2 - inserção sondagem quadrática\n");
 		printf("  3 - inserção duplo hashing\n");
+		printf("  4 - colisões de cada função de hash\n");
 		return 1;
 	}
 
@@ -166,6 +209,9 @@ int main(int argc, char *argv[]) {
 		case 3:
 			teste_inserir_duplo(tamanho);
 			break;
+		case 4:
+			teste_funcoes_hash(tamanho);
+			break;
 		default:
 			printf("Tipo de teste inválido\n");
 			return 1;
@@ -1,14 +1,28 @@
 #include "hash.h"
 
+#define NODOS_POR_BLOCO 256
+
 typedef struct nodo {
 	TipoElemento *elemento;
 	struct nodo *prox;
 } Nodo;
 
+// Os nodos não são alocados um a um: saem de blocos contíguos (pool da tabela). Um nodo
+// removido volta para a lista de livres, encadeado pelo próprio campo prox.
+typedef struct bloco_nodos {
+	struct bloco_nodos *prox;
+	int capacidade;
+	Nodo nodos[];
+} BlocoNodos;
+
 struct hash {
 	int qtde, tamanho;
 	Nodo **itens; // vetor de listas encadeadas
 	int colisoes;
+	BlocoNodos *blocos; // primeiro bloco do pool
+	BlocoNodos *atual;  // bloco de onde saem os próximos nodos
+	int usados;         // nodos já entregues pelo bloco atual
+	Nodo *livres;       // nodos devolvidos, prontos para reuso
 };
 
 /**************************************
@@ -23,15 +37,83 @@ int hash_funcao(Hash* h, int chave){
 	return chave % h->tamanho;
 }
 
-// Cria um novo nodo para a lista encadeada
-Nodo* nodo_criar(TipoElemento *elemento) {
-	Nodo *novo = (Nodo*) malloc(sizeof(Nodo));
-	if (!novo) return NULL;
+static BlocoNodos* bloco_criar(int capacidade) {
+	BlocoNodos *b = (BlocoNodos*) malloc(sizeof(BlocoNodos) + sizeof(Nodo) * capacidade);
+	if (!b) return NULL;
+	b->prox = NULL;
+	b->capacidade = capacidade;
+	return b;
+}
+
+static void blocos_liberar(BlocoNodos *b) {
+	while (b != NULL) {
+		BlocoNodos *tmp = b;
+		b = b->prox;
+		free(tmp);
+	}
+}
+
+// Cria um novo nodo para a lista encadeada: reaproveita um nodo devolvido ou pega o próximo do
+// bloco atual. Só chama malloc quando todos os blocos do pool estão ocupados; o novo bloco
+// cresce com a tabela, então o número de blocos fica logarítmico na quantidade de elementos.
+static Nodo* nodo_criar(Hash *h, TipoElemento *elemento) {
+	Nodo *novo = h->livres;
+	if (novo != NULL) {
+		h->livres = novo->prox;
+	} else {
+		if (h->atual == NULL || h->usados == h->atual->capacidade) {
+			if (h->atual != NULL && h->atual->prox != NULL) {
+				h->atual = h->atual->prox; // bloco mantido por hash_limpar
+			} else {
+				BlocoNodos *b = bloco_criar(h->qtde > NODOS_POR_BLOCO ? h->qtde : NODOS_POR_BLOCO);
+				if (!b) return NULL;
+				if (h->atual == NULL) h->blocos = b;
+				else h->atual->prox = b;
+				h->atual = b;
+			}
+			h->usados = 0;
+		}
+		novo = &h->atual->nodos[h->usados++];
+	}
 	novo->elemento = elemento;
 	novo->prox = NULL;
 	return novo;
 }
 
+static void nodo_liberar(Hash *h, Nodo *nodo) {
+	nodo->prox = h->livres;
+	h->livres = nodo;
+}
+
+// Copia os nodos para um único bloco novo na ordem dos buckets, de modo que os nodos de uma
+// mesma lista fiquem lado a lado na memória; os blocos antigos são liberados de uma vez. Se
+// não houver memória para o bloco novo a tabela continua válida, apenas sem a compactação.
+static void hash_compactar(Hash *h) {
+	BlocoNodos *b = NULL;
+	if (h->qtde > 0) {
+		b = bloco_criar(h->qtde);
+		if (!b) return;
+
+		int k = 0;
+		for (int i = 0; i < h->tamanho; i++) {
+			Nodo **ligacao = &h->itens[i];
+			for (Nodo *atual = h->itens[i]; atual != NULL; atual = atual->prox) {
+				Nodo *copia = &b->nodos[k++];
+				copia->elemento = atual->elemento;
+				*ligacao = copia;
+				ligacao = &copia->prox;
+			}
+			*ligacao = NULL;
+		}
+	}
+
+	blocos_liberar(h->blocos);
+	h->blocos = b;
+	h->atual = b;
+	h->usados = h->qtde;
+	h->livres = NULL;
+}
+
 /**************************************
 * IMPLEMENTAÇÃO
 **************************************/
@@ -55,6 +137,10 @@ Hash* hash_criar(int tamanho){
 	h->qtde = 0;
 	h->tamanho = tamanho;
 	h->colisoes = 0;
+	h->blocos = NULL;
+	h->atual = NULL;
+	h->usados = 0;
+	h->livres = NULL;
 
 	return h;
 }
@@ -65,17 +151,14 @@ void hash_destruir(Hash** enderecoHash){
 
 	Hash *h = *enderecoHash;
 
-	// libera todas as listas encadeadas
+	// libera os elementos; os nodos são liberados junto com os blocos do pool
 	for (int i = 0; i < h->tamanho; i++) {
-		Nodo *atual = h->itens[i];
-		while (atual != NULL) {
-			Nodo *tmp = atual;
-			atual = atual->prox;
-			if (tmp->elemento) free(tmp->elemento);
-			free(tmp);
+		for (Nodo *atual = h->itens[i]; atual != NULL; atual = atual->prox) {
+			if (atual->elemento) free(atual->elemento);
 		}
 	}
 
+	blocos_liberar(h->blocos);
 	free(h->itens);
 	free(h);
 	*enderecoHash = NULL;
@@ -101,7 +184,7 @@ bool hash_inserir(Hash *h, TipoElemento *elemento){
 	}
 
 	// Insere no início da lista encadeada
-	Nodo *novo = nodo_criar(elemento);
+	Nodo *novo = nodo_criar(h, elemento);
 	if (novo == NULL) return false;
 
 	novo->prox = h->itens[pos];
@@ -142,7 +225,7 @@ bool hash_remover_linear(Hash *h, int chave, TipoElemento **elemento){
 				ant->prox = atual->prox;
 			}
 			*elemento = atual->elemento;
-			free(atual);
+			nodo_liberar(h, atual);
 			h->qtde--;
 			return true;
 		}
@@ -216,43 +299,18 @@ bool hash_redimensionar(Hash *h, int novo_tamanho) {
 	for (int i = 0; i < novo_tamanho; i++)
 		novos_itens[i] = NULL;
 
-	// Reinsere todos os elementos existentes na nova tabela
+	// Religa os nodos existentes no novo vetor, sem alocar nem liberar nenhum
 	for (int i = 0; i < h->tamanho; i++) {
 		Nodo *atual = h->itens[i];
 		while (atual != NULL) {
-			TipoElemento *el = atual->elemento;
-			int nova_pos = el->chave % novo_tamanho;
+			Nodo *prox = atual->prox;
+			int nova_pos = atual->elemento->chave % novo_tamanho;
 
 			// Insere no início da lista no novo vetor
-			Nodo *novo = (Nodo*) malloc(sizeof(Nodo));
-			if (!novo) {
-				// Em caso de erro, libera parcialmente e retorna false
-				for (int j = 0; j < novo_tamanho; j++) {
-					Nodo *tmp = novos_itens[j];
-					while (tmp != NULL) {
-						Nodo *prox = tmp->prox;
-						free(tmp);
-						tmp = prox;
-					}
-				}
-				free(novos_itens);
-				return false;
-			}
-			novo->elemento = el;
-			novo->prox = novos_itens[nova_pos];
-			novos_itens[nova_pos] = novo;
+			atual->prox = novos_itens[nova_pos];
+			novos_itens[nova_pos] = atual;
 
-			atual = atual->prox;
-		}
-	}
-
-	// Libera as listas antigas (não libera os elementos, pois foram realocados)
-	for (int i = 0; i < h->tamanho; i++) {
-		Nodo *atual = h->itens[i];
-		while (atual != NULL) {
-			Nodo *tmp = atual;
-			atual = atual->prox;
-			free(tmp);
+			atual = prox;
 		}
 	}
 
@@ -260,9 +318,32 @@ bool hash_redimensionar(Hash *h, int novo_tamanho) {
 	h->itens = novos_itens;
 	h->tamanho = novo_tamanho;
 
+	// Depois da religação os nodos de um bucket estão espalhados pelos blocos antigos
+	hash_compactar(h);
+
 	return true;
 }
 
+// Esvazia a tabela: os elementos (que pertencem à tabela) são liberados, mas os nodos voltam
+// todos ao pool de uma vez, sem percorrer a lista de livres. Os blocos são mantidos para as
+// próximas inserções.
+void hash_limpar(Hash *h) {
+	if (!hash_ehValida(h)) return;
+
+	for (int i = 0; i < h->tamanho; i++) {
+		for (Nodo *atual = h->itens[i]; atual != NULL; atual = atual->prox) {
+			if (atual->elemento) free(atual->elemento);
+		}
+		h->itens[i] = NULL;
+	}
+
+	h->qtde = 0;
+	h->colisoes = 0;
+	h->atual = h->blocos;
+	h->usados = 0;
+	h->livres = NULL;
+}
+
 int hash_colisoes(Hash *h){
 	if (!hash_ehValida(h)) return -1;
 	return h->colisoes;
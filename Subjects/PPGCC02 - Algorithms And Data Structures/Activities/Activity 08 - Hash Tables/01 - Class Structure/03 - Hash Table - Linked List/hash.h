@@ -27,6 +27,7 @@ bool hash_remover_linear(Hash *h, int chave, TipoElemento **elemento);
 void hash_listar(Hash *h);
 float hash_fator_carga(Hash *h);
 bool hash_redimensionar(Hash *h, int novo_tamanho);
+void hash_limpar(Hash *h);
 int hash_colisoes(Hash *h);
 
 #endif
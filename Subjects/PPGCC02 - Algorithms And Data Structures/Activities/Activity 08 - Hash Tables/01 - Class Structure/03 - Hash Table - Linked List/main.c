@@ -109,6 +109,13 @@ int main() {
 		printf("Falha no redimensionamento\n");
 	}
 
+	// Limpeza: os nodos voltam ao pool e são reaproveitados pelas próximas inserções
+	printf("\n=========== LIMPEZA ===========\n");
+	hash_limpar(h);
+	printf("Hash está vazio após limpar? %s\n", hash_vazio(h) ? "Sim" : "Não");
+	teste_inserir(h, 15);
+	hash_imprimir(h);
+
 	// Liberação de memória
 	printf("\n=========== FINALIZAÇÃO ===========\n");
 	hash_destruir(&h);
@@ -0,0 +1,106 @@
+// Endereçamento aberto (pasta 01, modo ponteiro): sem tratamento de colisão e com as sondagens
+// linear, quadrática e dupla. O hash.c é incluído para medir as sondagens pela posição de cada chave.
+#include "../01 - Hash Table/hash.c"
+#include "estrategia.h"
+
+// No modo ponteiro os elementos são do chamador: saem de um vetor alocado junto com a tabela
+typedef struct {
+	Hash *h;
+	TipoElemento *elementos;
+	int usados;
+} Aberta;
+
+static void* aberta_criar(int tamanho) {
+	Aberta *a = (Aberta*) malloc(sizeof(Aberta));
+	if (a == NULL) return NULL;
+	a->h = hash_criar_modo(tamanho, HASH_PONTEIRO);
+	a->elementos = (TipoElemento*) malloc(sizeof(TipoElemento) * tamanho);
+	a->usados = 0;
+	if (a->h == NULL || a->elementos == NULL) {
+		hash_destruir(&a->h);
+		free(a->elementos);
+		free(a);
+		return NULL;
+	}
+	return a;
+}
+
+static void aberta_destruir(void *t) {
+	Aberta *a = (Aberta*) t;
+	hash_destruir(&a->h);
+	free(a->elementos);
+	free(a);
+}
+
+static bool aberta_gravar(Aberta *a, int chave, bool (*inserir)(Hash*, TipoElemento*)) {
+	TipoElemento *e = &a->elementos[a->usados];
+	e->chave = chave;
+	e->dado = chave;
+	if (!inserir(a->h, e)) return false;
+	a->usados++;
+	return true;
+}
+
+// Posições lidas por uma busca com acerto: a distância da origem até a posição da chave, mais um
+static void aberta_sondagem(void *t, double *media, int *maximo) {
+	Aberta *a = (Aberta*) t;
+	int classes = a->h->tamanho + 1;
+	int *histograma = (int*) malloc(sizeof(int) * classes);
+	if (histograma == NULL) {
+		*media = 0;
+		*maximo = 0;
+		return;
+	}
+
+	*maximo = hash_histograma_sondagem(a->h, histograma, classes) + 1;
+	long total = 0, elementos = 0;
+	for (int d = 0; d < classes; d++) {
+		total += (long) histograma[d] * (d + 1);
+		elementos += histograma[d];
+	}
+	*media = elementos > 0 ? (double) total / elementos : 0;
+	free(histograma);
+}
+
+// Sem tratamento de colisão a chave só pode estar na posição de origem. hash_remover retira o que
+// estiver na origem sem conferir a chave, então a remoção confere antes.
+static bool nenhuma_inserir(void *t, int chave) {
+	return aberta_gravar((Aberta*) t, chave, hash_inserir);
+}
+
+static bool nenhuma_buscar(void *t, int chave) {
+	Hash *h = ((Aberta*) t)->h;
+	TipoElemento *e = hash_posicao(h, hash_funcao(h, chave));
+	return e != NULL && e->chave == chave;
+}
+
+static bool nenhuma_remover(void *t, int chave) {
+	TipoElemento *e;
+	return nenhuma_buscar(t, chave) && hash_remover(((Aberta*) t)->h, chave, &e);
+}
+
+// Inserção, busca e remoção com a sondagem de sufixo (linear, quadratica ou duplo)
+#define SONDAGEM(sufixo) \
+	static bool sufixo##_inserir(void *t, int chave) { \
+		return aberta_gravar((Aberta*) t, chave, hash_inserir_##sufixo); \
+	} \
+	static bool sufixo##_buscar(void *t, int chave) { \
+		TipoElemento *e; \
+		return hash_buscar_##sufixo(((Aberta*) t)->h, chave, &e); \
+	} \
+	static bool sufixo##_remover(void *t, int chave) { \
+		TipoElemento *e; \
+		return hash_remover_##sufixo(((Aberta*) t)->h, chave, &e); \
+	}
+
+SONDAGEM(linear)
+SONDAGEM(quadratica)
+SONDAGEM(duplo)
+
+const Estrategia estrategias[] = {
+	{ "nenhuma",    aberta_criar, nenhuma_inserir,    nenhuma_buscar,    nenhuma_remover,    aberta_sondagem, aberta_destruir },
+	{ "linear",     aberta_criar, linear_inserir,     linear_buscar,     linear_remover,     aberta_sondagem, aberta_destruir },
+	{ "quadratica", aberta_criar, quadratica_inserir, quadratica_buscar, quadratica_remover, aberta_sondagem, aberta_destruir },
+	{ "duplo",      aberta_criar, duplo_inserir,      duplo_buscar,      duplo_remover,      aberta_sondagem, aberta_destruir },
+};
+const int num_estrategias = (int) (sizeof(estrategias) / sizeof(estrategias[0]));
@@ -0,0 +1,65 @@
+// Encadeamento separado (pasta 03). O adaptador da pasta 04 define HASH_C antes de incluir este
+// arquivo para medir a tabela com listas ordenadas, que tem a mesma estrutura de nodos.
+#ifndef HASH_C
+#define HASH_C "../03 - Hash Table - Linked List/hash.c"
+#define NOME_ESTRATEGIA "encadeada"
+#endif
+
+#include HASH_C
+#include "estrategia.h"
+
+static void* encadeada_criar(int tamanho) {
+	return hash_criar(tamanho);
+}
+
+// A tabela libera os elementos que ainda guarda ao ser destruída, então cada um é alocado à parte
+static bool encadeada_inserir(void *t, int chave) {
+	TipoElemento *e = (TipoElemento*) malloc(sizeof(TipoElemento));
+	if (e == NULL) return false;
+	e->chave = chave;
+	e->dado = chave;
+	if (hash_inserir((Hash*) t, e)) return true;
+	free(e);
+	return false;
+}
+
+static bool encadeada_buscar(void *t, int chave) {
+	TipoElemento *e;
+	return hash_buscar_linear((Hash*) t, chave, &e);
+}
+
+static bool encadeada_remover(void *t, int chave) {
+	TipoElemento *e;
+	if (!hash_remover_linear((Hash*) t, chave, &e)) return false;
+	free(e);
+	return true;
+}
+
+// Nodos lidos por uma busca com acerto: a posição da chave na lista (a partir de 1); o máximo é a
+// lista mais longa
+static void encadeada_sondagem(void *t, double *media, int *maximo) {
+	Hash *h = (Hash*) t;
+	long total = 0, elementos = 0;
+	*maximo = 0;
+	for (int i = 0; i < h->tamanho; i++) {
+		int comprimento = 0;
+		for (Nodo *n = h->itens[i]; n != NULL; n = n->prox) {
+			comprimento++;
+			total += comprimento;
+		}
+		elementos += comprimento;
+		if (comprimento > *maximo) *maximo = comprimento;
+	}
+	*media = elementos > 0 ? (double) total / elementos : 0;
+}
+
+static void encadeada_destruir(void *t) {
+	Hash *h = (Hash*) t;
+	hash_destruir(&h);
+}
+
+const Estrategia estrategias[] = {
+	{ NOME_ESTRATEGIA, encadeada_criar, encadeada_inserir, encadeada_buscar, encadeada_remover,
+	  encadeada_sondagem, encadeada_destruir },
+};
+const int num_estrategias = (int) (sizeof(estrategias) / sizeof(estrategias[0]));
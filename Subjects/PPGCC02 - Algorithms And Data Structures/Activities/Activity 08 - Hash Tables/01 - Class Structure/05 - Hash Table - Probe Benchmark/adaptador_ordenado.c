@@ -0,0 +1,6 @@
+// Encadeamento separado com listas ordenadas (pasta 04): as buscas sem acerto param ao passar da
+// chave. Reaproveita o adaptador da pasta 03, trocando só o hash.c incluído.
+#define HASH_C "../04 - Hash Table - Sorted Linked List/hash.c"
+#define NOME_ESTRATEGIA "encadeada_ordenada"
+
+#include "adaptador_encadeado.c"
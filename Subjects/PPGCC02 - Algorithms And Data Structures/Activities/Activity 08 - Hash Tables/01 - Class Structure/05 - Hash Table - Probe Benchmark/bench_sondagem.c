@@ -0,0 +1,248 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "estrategia.h"
+
+// Compara as estratégias de tratamento de colisão (nenhuma, sondagem linear, quadrática e dupla,
+// encadeamento e encadeamento ordenado) variando o fator de carga de 0,1 a 0,95 e a distribuição
+// das chaves. Para cada combinação mede a vazão de inserções, buscas com acerto, buscas sem acerto
+// e remoções, além do comprimento médio e máximo das sondagens das buscas com acerto, e imprime
+// uma linha CSV (pronta para gráficos), com as vazões em milhões de operações por segundo. Cada
+// adaptador vira um executável, e o make run junta as saídas em um único arquivo.
+// Uso: ./bench_aberto [tamanho] [semente] [--sem-cabecalho]
+
+#define TAMANHO_PADRAO 131071 // primo, como pedem as sondagens quadrática e dupla
+#define REPETICOES 3          // cada ponto é medido 3 vezes e fica a maior vazão de cada fase
+#define ORCAMENTO_NS 100000000ULL // tempo máximo de cada fase de busca ou remoção (100 ms)
+#define ZIPF_THETA 0.99       // inclinação da distribuição de Zipf (a mesma do YCSB)
+#define MASCARA_30 0x3FFFFFFFu
+
+static const double cargas[] = { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 0.95 };
+#define NUM_CARGAS (int) (sizeof(cargas) / sizeof(cargas[0]))
+
+typedef enum { UNIFORME, SEQUENCIAL, ESPACADA, ZIPF } Distribuicao;
+static const char *nomes_distribuicao[] = { "uniforme", "sequencial", "espacada", "zipf" };
+#define NUM_DISTRIBUICOES (int) (sizeof(nomes_distribuicao) / sizeof(nomes_distribuicao[0]))
+
+#define PASSO_ESPACADA 1024 // chaves múltiplas de 1024, como endereços alinhados ou ids com prefixo fixo
+
+static uint64_t estado; // gerador splitmix64, para execuções reproduzíveis
+static volatile int descarte; // recebe os resultados das buscas para o compilador não eliminá-las
+
+static uint64_t aleatorio(void) {
+	uint64_t z = (estado += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static double aleatorio_real(void) {
+	return (aleatorio() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static uint64_t agora_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+// Embaralha as 30 bits de i com uma bijeção (multiplicações por ímpares e xorshifts módulo 2^30):
+// índices diferentes dão chaves diferentes, não negativas e espalhadas por todo o intervalo
+static int misturar_30(uint32_t i) {
+	uint32_t x = (i * 0x2545F491u) & MASCARA_30;
+	x ^= x >> 15;
+	x = (x * 0x6F4F2A35u) & MASCARA_30;
+	x ^= x >> 13;
+	return (int) x;
+}
+
+// i-ésima chave da distribuição. As chaves ausentes usam os índices seguintes aos das presentes,
+// então nunca coincidem com elas e seguem o mesmo padrão. Na distribuição de Zipf as chaves são
+// uniformes e o que segue Zipf é a frequência com que cada uma é buscada.
+static int gerar_chave(Distribuicao d, int i) {
+	switch (d) {
+		case SEQUENCIAL: return i;
+		case ESPACADA:   return i * PASSO_ESPACADA;
+		default:         return misturar_30((uint32_t) i);
+	}
+}
+
+// Gerador de Zipf de Gray et al. (o do YCSB) sobre as posições [0, itens); a posição 0 é a mais buscada
+typedef struct {
+	int itens;
+	double zetan, alfa, eta, meio_elevado_theta;
+} Zipf;
+
+static void zipf_iniciar(Zipf *z, int itens) {
+	double zeta2 = 1.0 + pow(0.5, ZIPF_THETA);
+	z->itens = itens;
+	z->zetan = 0.0;
+	for (int i = 1; i <= itens; i++)
+		z->zetan += 1.0 / pow((double) i, ZIPF_THETA);
+	z->alfa = 1.0 / (1.0 - ZIPF_THETA);
+	z->eta = (1.0 - pow(2.0 / itens, 1.0 - ZIPF_THETA)) / (1.0 - zeta2 / z->zetan);
+	z->meio_elevado_theta = pow(0.5, ZIPF_THETA);
+}
+
+static int zipf_proximo(const Zipf *z) {
+	double u = aleatorio_real();
+	double uz = u * z->zetan;
+	if (uz < 1.0) return 0;
+	if (uz < 1.0 + z->meio_elevado_theta) return 1;
+	int pos = (int) (z->itens * pow(z->eta * u - z->eta + 1.0, z->alfa));
+	return pos < z->itens ? pos : z->itens - 1;
+}
+
+static void embaralhar(int v[], int n) {
+	for (int i = n - 1; i > 0; i--) {
+		int j = (int) (aleatorio() % (uint64_t) (i + 1));
+		int tmp = v[i];
+		v[i] = v[j];
+		v[j] = tmp;
+	}
+}
+
+static void falhar(const char *msg) {
+	fprintf(stderr, "%s\n", msg);
+	exit(1);
+}
+
+// Sequência de n buscas sobre as chaves[0..m): em ordem aleatória (cada chave uma vez) ou, na
+// distribuição de Zipf, sorteando as chaves com frequências de Zipf. Como no YCSB, cada posição de
+// Zipf vai para uma chave sorteada: direto sobre as chaves, as mais buscadas seriam as primeiras
+// inseridas, que ficam na posição de origem, e a medida seria a do melhor caso.
+static void gerar_buscas(Distribuicao d, const int chaves[], int m, int buscas[], int n) {
+	if (d == ZIPF) {
+		int *ordem = (int*) malloc(sizeof(int) * m);
+		if (ordem == NULL) falhar("Falha ao alocar memória");
+		memcpy(ordem, chaves, sizeof(int) * m);
+		embaralhar(ordem, m);
+
+		Zipf z;
+		zipf_iniciar(&z, m);
+		for (int i = 0; i < n; i++) buscas[i] = ordem[zipf_proximo(&z)];
+		free(ordem);
+		return;
+	}
+	memcpy(buscas, chaves, sizeof(int) * n);
+	embaralhar(buscas, n);
+}
+
+// Aplica a operação às chaves[0..m) e devolve a vazão em milhões de operações por segundo; *sucessos
+// recebe quantas devolveram true. A fase para ao estourar ORCAMENTO_NS, medindo só as operações
+// feitas até ali: sem isso as buscas sem acerto da sondagem linear com chaves sequenciais, que
+// percorrem o agrupamento inteiro, levariam tempo quadrático. *feitas recebe quantas rodaram.
+static double cronometrar(bool (*operacao)(void*, int), void *t, const int chaves[], int m, int *feitas, int *sucessos) {
+	uint64_t inicio = agora_ns(), tempo = 0;
+	int i = 0, ok = 0;
+	while (i < m) {
+		int fim = i + 256 < m ? i + 256 : m;
+		for (; i < fim; i++) ok += operacao(t, chaves[i]);
+		tempo = agora_ns() - inicio;
+		if (tempo > ORCAMENTO_NS) break;
+	}
+	*feitas = i;
+	*sucessos = ok;
+	descarte = ok;
+	return tempo == 0 ? 0.0 : i * 1e3 / tempo;
+}
+
+// Mede uma estratégia com uma distribuição e uma carga. As buscas e remoções usam só as chaves que
+// a inserção aceitou: sem tratamento de colisão, ou com a sondagem quadrática perto de encher a
+// tabela, parte das chaves não entra, e a coluna inseridos mostra quantas entraram.
+static void medir(const Estrategia *est, Distribuicao d, double carga, int tamanho, const int chaves[],
+                  const int ausentes[], int inseridas[], int buscas[], int falhas[], int remocoes[]) {
+	int n = (int) (tamanho * carga);
+	double melhor[4] = { 0, 0, 0, 0 }; // maior vazão de cada fase entre as repetições
+	int m = 0;
+	double sondagem_media = 0;
+	int sondagem_max = 0;
+
+	for (int r = 0; r < REPETICOES; r++) {
+		void *t = est->criar(tamanho);
+		if (t == NULL) falhar("Falha ao criar hash");
+
+		uint64_t inicio = agora_ns();
+		int aceitas = 0;
+		for (int i = 0; i < n; i++)
+			if (est->inserir(t, chaves[i])) inseridas[aceitas++] = chaves[i];
+		uint64_t tempo = agora_ns() - inicio;
+		double vazao = tempo == 0 ? 0.0 : n * 1e3 / tempo;
+		if (vazao > melhor[0]) melhor[0] = vazao;
+
+		// As sequências de busca são sorteadas uma vez; as repetições reusam as mesmas
+		if (r == 0) {
+			m = aceitas;
+			est->sondagem(t, &sondagem_media, &sondagem_max);
+			gerar_buscas(d, inseridas, m, buscas, m);
+			gerar_buscas(d, ausentes, n, falhas, m);
+			memcpy(remocoes, inseridas, sizeof(int) * m);
+			embaralhar(remocoes, m);
+		}
+
+		int feitas, sucessos;
+		vazao = cronometrar(est->buscar, t, buscas, m, &feitas, &sucessos);
+		if (vazao > melhor[1]) melhor[1] = vazao;
+		if (sucessos != feitas) falhar("Busca não encontrou uma chave inserida");
+
+		vazao = cronometrar(est->buscar, t, falhas, m, &feitas, &sucessos);
+		if (vazao > melhor[2]) melhor[2] = vazao;
+		if (sucessos != 0) falhar("Busca encontrou uma chave ausente");
+
+		vazao = cronometrar(est->remover, t, remocoes, m, &feitas, &sucessos);
+		if (vazao > melhor[3]) melhor[3] = vazao;
+		if (sucessos != feitas) falhar("Remoção não encontrou uma chave inserida");
+
+		est->destruir(t);
+	}
+
+	printf("%s,%s,%.2f,%d,%d,%.2f,%.2f,%.2f,%.2f,%.3f,%d\n", est->nome, nomes_distribuicao[d], carga,
+		tamanho, m, melhor[0], melhor[1], melhor[2], melhor[3], sondagem_media, sondagem_max);
+	fflush(stdout);
+}
+
+int main(int argc, char *argv[]) {
+	int tamanho = argc > 1 ? atoi(argv[1]) : TAMANHO_PADRAO;
+	estado = argc > 2 ? strtoull(argv[2], NULL, 10) : 42;
+	bool cabecalho = !(argc > 3 && strcmp(argv[3], "--sem-cabecalho") == 0);
+	// As chaves espaçadas precisam caber em um int (2 * tamanho * 1024 < 2^31)
+	if (tamanho < 16 || tamanho > (1 << 20)) {
+		fprintf(stderr, "Uso: %s [tamanho (16 a 1048576)] [semente] [--sem-cabecalho]\n", argv[0]);
+		return 1;
+	}
+
+	int *chaves = (int*) malloc(sizeof(int) * tamanho);
+	int *ausentes = (int*) malloc(sizeof(int) * tamanho);
+	int *inseridas = (int*) malloc(sizeof(int) * tamanho);
+	int *buscas = (int*) malloc(sizeof(int) * tamanho);
+	int *falhas = (int*) malloc(sizeof(int) * tamanho);
+	int *remocoes = (int*) malloc(sizeof(int) * tamanho);
+	if (!chaves || !ausentes || !inseridas || !buscas || !falhas || !remocoes)
+		falhar("Falha ao alocar memória");
+
+	if (cabecalho)
+		printf("estrategia,distribuicao,carga,tamanho,inseridos,insercao_mops,busca_acerto_mops,"
+			"busca_falha_mops,remocao_mops,sondagem_media,sondagem_max\n");
+
+	for (int d = 0; d < NUM_DISTRIBUICOES; d++) {
+		for (int i = 0; i < tamanho; i++) {
+			chaves[i] = gerar_chave((Distribuicao) d, i);
+			ausentes[i] = gerar_chave((Distribuicao) d, tamanho + i);
+		}
+		for (int e = 0; e < num_estrategias; e++)
+			for (int c = 0; c < NUM_CARGAS; c++)
+				medir(&estrategias[e], (Distribuicao) d, cargas[c], tamanho, chaves, ausentes,
+					inseridas, buscas, falhas, remocoes);
+	}
+
+	free(chaves);
+	free(ausentes);
+	free(inseridas);
+	free(buscas);
+	free(falhas);
+	free(remocoes);
+	return 0;
+}
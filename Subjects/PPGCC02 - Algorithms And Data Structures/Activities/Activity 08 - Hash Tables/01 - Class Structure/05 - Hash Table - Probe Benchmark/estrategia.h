@@ -0,0 +1,24 @@
+#ifndef _ESTRATEGIA_H_
+#define _ESTRATEGIA_H_
+
+#include <stdbool.h>
+
+// Interface que cada adaptador expõe ao bench_sondagem. As tabelas das pastas 01, 03 e 04 definem
+// as mesmas funções (hash_criar, hash_inserir...), então cada adaptador inclui o hash.c da sua
+// pasta e vira um executável separado; o adaptador também lê a estrutura interna da tabela para
+// medir o comprimento das sondagens.
+typedef struct {
+	const char *nome;
+	void* (*criar)(int tamanho);
+	bool (*inserir)(void *tabela, int chave); // false se a chave não coube (tabela cheia ou colisão sem tratamento)
+	bool (*buscar)(void *tabela, int chave);
+	bool (*remover)(void *tabela, int chave);
+	// Posições (ou nodos) lidas por uma busca com acerto, em média e no pior caso, para as chaves presentes
+	void (*sondagem)(void *tabela, double *media, int *maximo);
+	void (*destruir)(void *tabela);
+} Estrategia;
+
+extern const Estrategia estrategias[];
+extern const int num_estrategias;
+
+#endif
@@ -2,7 +2,9 @@
  * Description: This program implements a hash table with chaining using linked lists
  * to handle collisions. It inserts a set of integer keys, prints the contents
  * of the hash table, and allows for key search and deletion. It also identifies
- * the bucket with the longest chain (worst-case access).
+ * the bucket with the longest chain (worst-case access). Nodes come from a per-table pool of
+ * contiguous slabs with an intrusive free list, so clearing the table frees nothing node by node,
+ * and resizing lays out each bucket's chain contiguously in memory.
  * Author: Breno Farias da Silva.
  * Date: 07/06/2025.
  */
@@ -14,6 +16,7 @@
 #include <stdlib.h> // malloc, free
 
 #define TABLE_SIZE 13 // Prime number for better distribution
+#define SLAB_NODES 256 // Minimum number of nodes allocated at once by the pool
 
 /*
  * Node of the linked list used for chaining in the hash table.
@@ -23,26 +26,107 @@ typedef struct Node {
 	struct Node* next;
 } Node;
 
+/*
+ * Contiguous block of nodes owned by the pool.
+ */
+typedef struct Slab {
+	struct Slab* next; // Next slab of the pool
+	int capacity; // Number of nodes in this slab
+	Node nodes[];
+} Slab;
+
+/*
+ * Per-table node allocator: nodes are handed out from slabs in order, and deleted nodes are
+ * kept in a free list threaded through their own next field.
+ */
+typedef struct {
+	Slab* first; // First slab (slabs are kept after a clear and reused in order)
+	Slab* current; // Slab the next fresh node comes from
+	int used; // Nodes already handed out from the current slab
+	Node* free_list; // Deleted nodes ready for reuse
+} NodePool;
+
 /*
 * Hash table structure using chaining.
 */
 typedef struct {
 	Node** table; // Array of linked list heads
 	int size; // Number of buckets
+	int count; // Number of stored keys
+	NodePool pool; // Allocator of the chain nodes
 } HashTable;
 
 /*
-* Creates a new node with the given key.
+ * Allocates a slab able to hold the given number of nodes.
+ * @param capacity Number of nodes of the slab.
+ * @return Pointer to the slab, or NULL if the allocation fails.
+ */
+Slab* create_slab(int capacity) {
+	Slab* slab = (Slab*)malloc(sizeof(Slab) + capacity * sizeof(Node));
+	if (slab == NULL)
+		return NULL;
+	slab->next = NULL;
+	slab->capacity = capacity;
+	return slab;
+}
+
+/*
+ * Frees a list of slabs.
+ * @param slab First slab of the list.
+ */
+void free_slabs(Slab* slab) {
+	while (slab != NULL) {
+		Slab* temp = slab;
+		slab = slab->next;
+		free(temp);
+	}
+}
+
+/*
+* Creates a new node with the given key, reusing a deleted node when there is one.
+* A new slab (as large as the table, at least SLAB_NODES) is only allocated when every slab is used.
+* @param table Pointer to the hash table that owns the node.
 * @param key Integer key to store in the node.
-* @return Pointer to the created node.
+* @return Pointer to the created node, or NULL if the allocation fails.
 */
-Node* create_node(int key) {
-	Node* new_node = (Node*)malloc(sizeof(Node));
+Node* create_node(HashTable* table, int key) {
+	NodePool* pool = &table->pool;
+	Node* new_node = pool->free_list;
+	if (new_node != NULL) {
+		pool->free_list = new_node->next;
+	} else {
+		if (pool->current == NULL || pool->used == pool->current->capacity) {
+			if (pool->current != NULL && pool->current->next != NULL) {
+				pool->current = pool->current->next; // Slab kept by a previous clear
+			} else {
+				Slab* slab = create_slab(table->count > SLAB_NODES ? table->count : SLAB_NODES);
+				if (slab == NULL)
+					return NULL;
+				if (pool->current == NULL)
+					pool->first = slab;
+				else
+					pool->current->next = slab;
+				pool->current = slab;
+			}
+			pool->used = 0;
+		}
+		new_node = &pool->current->nodes[pool->used++];
+	}
 	new_node->key = key;
 	new_node->next = NULL;
 	return new_node;
 }
 
+/*
+ * Returns a node to the pool's free list.
+ * @param table Pointer to the hash table that owns the node.
+ * @param node Node to release.
+ */
+void release_node(HashTable* table, Node* node) {
+	node->next = table->pool.free_list;
+	table->pool.free_list = node;
+}
+
 /*
 * Initializes a hash table with all buckets set to NULL.
 * @param table Pointer to the hash table.
@@ -50,6 +134,8 @@ Node* create_node(int key) {
 */
 void initialize_table(HashTable* table, int size) {
 	table->size = size;
+	table->count = 0;
+	table->pool = (NodePool){NULL, NULL, 0, NULL};
 	table->table = (Node**)malloc(size * sizeof(Node*));
 	for (int i = 0; i < size; i++) {
 		table->table[i] = NULL;
@@ -73,9 +159,12 @@ int hash(HashTable* table, int key) {
 */
 void insert_key(HashTable* table, int key) {
 	int index = hash(table, key);
-	Node* new_node = create_node(key);
+	Node* new_node = create_node(table, key);
+	if (new_node == NULL)
+		return;
 	new_node->next = table->table[index];
 	table->table[index] = new_node;
+	table->count++;
 }
 
 /*
@@ -111,7 +200,8 @@ int delete_key(HashTable* table, int key) {
 				table->table[index] = current->next;
 			else
 				prev->next = current->next;
-			free(current);
+			release_node(table, current);
+			table->count--;
 			return 1;
 		}
 		prev = current;
@@ -137,19 +227,69 @@ void print_table(HashTable* table) {
 }
 
 /*
- * Clear the hash table by freeing all nodes and their arrays.
+ * Resizes the hash table, relinking the existing nodes into the new buckets and then copying
+ * them into a single slab in bucket order, so that each chain is contiguous in memory.
  * @param table Pointer to the hash table.
+ * @param new_size New number of buckets.
+ * @return 1 if resized, 0 if the allocation fails.
  */
-void clear_table(HashTable* table) {
+int resize_table(HashTable* table, int new_size) {
+	Node** new_table = (Node**)malloc(new_size * sizeof(Node*));
+	if (new_table == NULL)
+		return 0;
+	for (int i = 0; i < new_size; i++) {
+		new_table[i] = NULL;
+	}
+
 	for (int i = 0; i < table->size; i++) {
 		Node* current = table->table[i];
 		while (current != NULL) {
-			Node* temp = current;
-			current = current->next;
-			free(temp);
+			Node* next = current->next;
+			int index = current->key % new_size;
+			current->next = new_table[index];
+			new_table[index] = current;
+			current = next;
+		}
+	}
+	free(table->table);
+	table->table = new_table;
+	table->size = new_size;
+
+	Slab* slab = NULL;
+	if (table->count > 0) {
+		slab = create_slab(table->count);
+		if (slab == NULL)
+			return 1; // Still a valid table, just not compacted
+		int k = 0;
+		for (int i = 0; i < new_size; i++) {
+			Node** link = &table->table[i];
+			for (Node* current = table->table[i]; current != NULL; current = current->next) {
+				Node* copy = &slab->nodes[k++];
+				copy->key = current->key;
+				*link = copy;
+				link = &copy->next;
+			}
+			*link = NULL;
 		}
+	}
+	free_slabs(table->pool.first);
+	table->pool = (NodePool){slab, slab, table->count, NULL};
+	return 1;
+}
+
+/*
+ * Clears the hash table in constant time with respect to the number of keys: no node is freed,
+ * the pool just starts handing out its slabs from the beginning again.
+ * @param table Pointer to the hash table.
+ */
+void clear_table(HashTable* table) {
+	for (int i = 0; i < table->size; i++) {
 		table->table[i] = NULL;
 	}
+	table->count = 0;
+	table->pool.current = table->pool.first;
+	table->pool.used = 0;
+	table->pool.free_list = NULL;
 }
 
 /*
@@ -157,14 +297,7 @@ void clear_table(HashTable* table) {
 * @param table Pointer to the hash table.
 */
 void free_table(HashTable* table) {
-	for (int i = 0; i < table->size; i++) {
-		Node* current = table->table[i];
-		while (current != NULL) {
-			Node* temp = current;
-			current = current->next;
-			free(temp);
-		}
-	}
+	free_slabs(table->pool.first);
 	free(table->table);
 }
 
@@ -204,6 +337,10 @@ int main(int argc, char* argv[]) {
 	printf("\nTable after deletion:\n");
 	print_table(&table);
 
+	resize_table(&table, 2 * TABLE_SIZE + 1);
+	printf("\nTable after resizing to %d buckets:\n", table.size);
+	print_table(&table);
+
 	clear_table(&table);
 	printf("\nTable after clearing:\n");
 	print_table(&table);
@@ -1,7 +1,10 @@
 /*
  * Description: This program implements a hash table using separate chaining
- * with linked lists, where each node contains a sorted array of integers.
- * Binary search is used within each array to locate keys efficiently.
+ * with unrolled linked lists: each bucket keeps its keys sorted across a chain
+ * of 64-byte blocks (one cache line each), with the keys stored inline. A full
+ * block is split in two, the largest key of each block works as a fence that
+ * lets a search skip the whole block, and the membership test within a block
+ * compares every key at once with SIMD instructions (binary search without SSE2).
  * Author: Breno Farias da Silva.
  * Date: 07/06/2025.
  */
@@ -10,39 +13,49 @@
 // Run: ./main
 
 #include <stdio.h> // printf
-#include <stdlib.h> // malloc, free, realloc
+#include <stdlib.h> // malloc, free, aligned_alloc, rand
+#include <string.h> // memmove, memset
+#ifdef __SSE2__
+#include <emmintrin.h> // _mm_cmpeq_epi32, _mm_movemask_ps
+#endif
 
 #define TABLE_SIZE 13 // Prime number for better distribution
-#define BLOCK_CAPACITY 4 // Initial array size per node
+#define BLOCK_BYTES 64 // Size of a block (one cache line)
+#define BLOCK_CAPACITY 12 // Keys per block: 48 bytes of keys plus a 16-byte header
+#define MERGE_THRESHOLD 9 // Neighbour blocks holding this many keys together are merged
 
 /*
- * Node of the linked list, each holding a sorted array of integers.
+ * Block of an unrolled chain. The keys of a bucket are sorted across the whole chain: every key
+ * of a block is smaller than every key of the next one.
  */
 typedef struct Node {
-	int* keys; // Sorted array of keys
-	int count; // Number of keys in the array
-	int capacity; // Capacity of the array
-	struct Node* next; // Pointer to the next node
+	int keys[BLOCK_CAPACITY]; // Sorted keys, stored inline (16-byte aligned for SIMD loads)
+	int count; // Number of keys in the block
+	int fence; // Largest key in the block (keys[count - 1])
+	struct Node* next; // Pointer to the next block
 } Node;
 
+_Static_assert(sizeof(Node) == BLOCK_BYTES, "a block must fill exactly one cache line");
+
 /*
 * Hash table structure using chaining.
 */
 typedef struct {
-	Node** table; // Array of linked list heads
+	Node** table; // Array of chain heads
 	int size; // Number of buckets
+	int count; // Number of stored keys
+	int blocks; // Number of allocated blocks
 } HashTable;
 
 /*
-* Creates a new node with initialized array.
-* @return Pointer to the created node.
+* Creates a new empty block aligned to a cache line.
+* @return Pointer to the created block, or NULL if the allocation fails.
 */
 Node* create_node() {
-	Node* new_node = (Node*)malloc(sizeof(Node));
-	new_node->keys = (int*)malloc(BLOCK_CAPACITY * sizeof(int));
-	new_node->count = 0;
-	new_node->capacity = BLOCK_CAPACITY;
-	new_node->next = NULL;
+	Node* new_node = (Node*)aligned_alloc(BLOCK_BYTES, sizeof(Node));
+	if (new_node == NULL)
+		return NULL;
+	memset(new_node, 0, sizeof(Node));
 	return new_node;
 }
 
@@ -53,6 +66,8 @@ Node* create_node() {
 */
 void initialize_table(HashTable* table, int size) {
 	table->size = size;
+	table->count = 0;
+	table->blocks = 0;
 	table->table = (Node**)malloc(size * sizeof(Node*));
 	for (int i = 0; i < size; i++) {
 		table->table[i] = NULL;
@@ -76,7 +91,7 @@ int hash(HashTable* table, int key) {
 * @param key Key to search for.
 * @return Index if found, -1 otherwise.
 */
-int binary_search(int* arr, int size, int key) {
+int binary_search(const int* arr, int size, int key) {
 	int left = 0, right = size - 1;
 	while (left <= right) {
 		int mid = left + (right - left) / 2;
@@ -91,45 +106,113 @@ int binary_search(int* arr, int size, int key) {
 }
 
 /*
-* Inserts a key into a sorted array within a node.
-* @param node Pointer to the node.
+ * Finds a key within a block. With SSE2 the key is compared against the 12 slots with three
+ * 4-lane comparisons and no branches; the slots past count are masked out of the result.
+ * @param node Pointer to the block.
+ * @param key Key to search for.
+ * @return Index of the key in the block, -1 if absent.
+ */
+int block_find(const Node* node, int key) {
+#ifdef __SSE2__
+	__m128i target = _mm_set1_epi32(key);
+	unsigned mask = 0;
+	for (int i = 0; i < BLOCK_CAPACITY; i += 4) {
+		__m128i lanes = _mm_load_si128((const __m128i*)&node->keys[i]);
+		mask |= (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lanes, target))) << i;
+	}
+	mask &= (1u << node->count) - 1;
+	return mask ? __builtin_ctz(mask) : -1;
+#else
+	return binary_search(node->keys, node->count, key);
+#endif
+}
+
+/*
+ * Walks a chain to the only block that may contain the key, using the fences to skip blocks.
+ * @param head First block of the chain.
+ * @param key Key to locate.
+ * @param prev Output: block before the returned one (NULL if it is the head), may be NULL.
+ * @return First block whose fence is not smaller than the key, or the last block of the chain.
+ */
+Node* find_block(Node* head, int key, Node** prev) {
+	Node* before = NULL;
+	Node* current = head;
+	while (current != NULL && current->next != NULL && current->fence < key) {
+		before = current;
+		current = current->next;
+	}
+	if (prev != NULL)
+		*prev = before;
+	return current;
+}
+
+/*
+* Inserts a key into a block with free space, keeping it sorted.
+* @param node Pointer to the block.
 * @param key Key to insert.
 */
 void insert_into_node(Node* node, int key) {
-	if (node->count == node->capacity) {
-		node->capacity *= 2;
-		node->keys = (int*)realloc(node->keys, node->capacity * sizeof(int));
-	}
-	int i = node->count - 1;
-	while (i >= 0 && node->keys[i] > key) {
-		node->keys[i + 1] = node->keys[i];
+	int i = node->count;
+	while (i > 0 && node->keys[i - 1] > key)
 		i--;
-	}
-	node->keys[i + 1] = key;
+	memmove(&node->keys[i + 1], &node->keys[i], (node->count - i) * sizeof(int));
+	node->keys[i] = key;
 	node->count++;
+	node->fence = node->keys[node->count - 1];
+}
+
+/*
+ * Splits a full block, moving its upper half to a new block linked right after it.
+ * @param table Pointer to the hash table.
+ * @param node Pointer to the full block.
+ * @return Pointer to the new block, or NULL if the allocation fails.
+ */
+Node* split_node(HashTable* table, Node* node) {
+	Node* upper = create_node();
+	if (upper == NULL)
+		return NULL;
+	int half = node->count / 2;
+	upper->count = node->count - half;
+	memcpy(upper->keys, &node->keys[half], upper->count * sizeof(int));
+	upper->fence = node->fence;
+	upper->next = node->next;
+	node->count = half;
+	node->fence = node->keys[half - 1];
+	node->next = upper;
+	table->blocks++;
+	return upper;
 }
 
 /*
 * Inserts a key into the hash table.
 * @param table Pointer to the hash table.
 * @param key Key to insert.
+* @return 1 if inserted, 0 if the key already exists or memory is exhausted.
 */
-void insert_key(HashTable* table, int key) {
+int insert_key(HashTable* table, int key) {
 	int index = hash(table, key);
-	Node* current = table->table[index];
-	while (current != NULL) {
-		if (binary_search(current->keys, current->count, key) != -1)
-			return; // Key already exists
-		current = current->next;
+	if (table->table[index] == NULL) {
+		Node* head = create_node();
+		if (head == NULL)
+			return 0;
+		table->table[index] = head;
+		table->blocks++;
 	}
-	// Insert in the first node or create a new one if necessary
-	current = table->table[index];
-	if (current == NULL) {
-		table->table[index] = create_node();
-		insert_into_node(table->table[index], key);
-	} else {
-		insert_into_node(current, key); // Insert into first node
+
+	Node* current = find_block(table->table[index], key, NULL);
+	if (block_find(current, key) != -1)
+		return 0; // Key already exists
+
+	if (current->count == BLOCK_CAPACITY) {
+		Node* upper = split_node(table, current);
+		if (upper == NULL)
+			return 0;
+		if (key > current->fence)
+			current = upper;
 	}
+	insert_into_node(current, key);
+	table->count++;
+	return 1;
 }
 
 /*
@@ -141,34 +224,55 @@ void insert_key(HashTable* table, int key) {
 int search_key(HashTable* table, int key) {
 	int index = hash(table, key);
 	Node* current = table->table[index];
-	while (current != NULL) {
-		if (binary_search(current->keys, current->count, key) != -1)
-			return 1;
-		current = current->next;
-	}
-	return 0;
+	while (current != NULL && current->fence < key)
+		current = current->next; // The key cannot be in a block whose fence is smaller
+	return current != NULL && block_find(current, key) != -1;
 }
 
 /*
-* Deletes a key from the hash table.
+* Deletes a key from the hash table. An emptied block is unlinked, and a block is merged with
+* a neighbour when both fit comfortably in one, so chains stay short after many deletions.
 * @param table Pointer to the hash table.
 * @param key Key to delete.
 * @return 1 if deleted, 0 if not found.
 */
 int delete_key(HashTable* table, int key) {
 	int index = hash(table, key);
-	Node* current = table->table[index];
-	while (current != NULL) {
-		int pos = binary_search(current->keys, current->count, key);
-		if (pos != -1) {
-			for (int i = pos; i < current->count - 1; i++)
-				current->keys[i] = current->keys[i + 1];
-			current->count--;
-			return 1;
-		}
-		current = current->next;
+	Node* prev;
+	Node* current = find_block(table->table[index], key, &prev);
+	if (current == NULL)
+		return 0;
+	int pos = block_find(current, key);
+	if (pos == -1)
+		return 0;
+
+	current->count--;
+	memmove(&current->keys[pos], &current->keys[pos + 1], (current->count - pos) * sizeof(int));
+	table->count--;
+
+	if (current->count == 0) {
+		if (prev == NULL)
+			table->table[index] = current->next;
+		else
+			prev->next = current->next;
+		free(current);
+		table->blocks--;
+		return 1;
 	}
-	return 0;
+	current->fence = current->keys[current->count - 1];
+
+	if (prev != NULL && prev->count + current->count <= MERGE_THRESHOLD)
+		current = prev; // Merge into the previous block instead
+	Node* next = current->next;
+	if (next != NULL && current->count + next->count <= MERGE_THRESHOLD) {
+		memcpy(&current->keys[current->count], next->keys, next->count * sizeof(int));
+		current->count += next->count;
+		current->fence = next->fence;
+		current->next = next->next;
+		free(next);
+		table->blocks--;
+	}
+	return 1;
 }
 
 /*
@@ -190,7 +294,24 @@ void print_table(HashTable* table) {
 }
 
 /*
- * Clear the hash table by freeing all nodes and their arrays.
+ * Prints how full the chains are: keys per block measure how well the cache lines are used.
+ * @param table Pointer to the hash table.
+ */
+void print_stats(HashTable* table) {
+	int longest = 0;
+	for (int i = 0; i < table->size; i++) {
+		int length = 0;
+		for (Node* current = table->table[i]; current != NULL; current = current->next)
+			length++;
+		if (length > longest)
+			longest = length;
+	}
+	printf("Keys: %d, buckets: %d, blocks: %d (%d bytes each)\n", table->count, table->size, table->blocks, BLOCK_BYTES);
+	printf("Keys per block: %.2f of %d, longest chain: %d blocks\n", table->blocks ? (double)table->count / table->blocks : 0.0, BLOCK_CAPACITY, longest);
+}
+
+/*
+ * Clear the hash table by freeing all blocks.
  * @param table Pointer to the hash table.
  */
 void clear_table(HashTable* table) {
@@ -199,11 +320,12 @@ void clear_table(HashTable* table) {
 		while (current != NULL) {
 			Node* temp = current;
 			current = current->next;
-			free(temp->keys);
 			free(temp);
 		}
 		table->table[i] = NULL;
 	}
+	table->count = 0;
+	table->blocks = 0;
 }
 
 /*
@@ -216,7 +338,6 @@ void free_table(HashTable* table) {
 		while (current != NULL) {
 			Node* temp = current;
 			current = current->next;
-			free(temp->keys);
 			free(temp);
 		}
 	}
@@ -260,6 +381,24 @@ int main() {
 	printf("\nTable after clearing:\n");
 	print_table(&table);
 
+	// High load: about 150 keys per bucket, then half of them deleted
+	int high_load = 2000;
+	srand(42);
+	for (int i = 0; i < high_load; i++)
+		insert_key(&table, rand() % (high_load * 4));
+	printf("\nAfter inserting %d random keys:\n", high_load);
+	print_stats(&table);
+
+	int found = 0;
+	for (int key = 0; key < high_load * 4; key++)
+		found += search_key(&table, key);
+	printf("Keys found by search: %d\n", found);
+
+	for (int key = 0; key < high_load * 4; key += 2)
+		delete_key(&table, key);
+	printf("\nAfter deleting the even keys:\n");
+	print_stats(&table);
+
 	free_table(&table);
 	return 0;
 }
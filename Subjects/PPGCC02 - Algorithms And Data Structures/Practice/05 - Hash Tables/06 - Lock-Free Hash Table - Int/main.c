@@ -0,0 +1,573 @@
+/*
+* Description: This program implements a lock-free hash map for integer keys and values.
+* Every slot is a single 64-bit word packing {key, value}, updated with compare-and-swap
+* under linear probing. Deletions leave tombstones, and when a table gets too full the
+* threads that touch it cooperate to migrate it into a larger one. A multithreaded stress
+* harness checks the map under contention and compares a hot counter map against the
+* same map guarded by a mutex.
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+// Compile: gcc -Wall -O2 -pthread main.c -o main
+// Run: ./main [threads] [operations per thread]
+
+#include <stdio.h> // printf
+#include <stdlib.h> // malloc, calloc, free, atoi
+#include <stdint.h> // uint64_t, uint32_t, int64_t, INT32_MIN, INT32_MAX
+#include <stdbool.h> // bool
+#include <stdatomic.h> // atomic_*
+#include <pthread.h> // pthread_create, pthread_join, pthread_mutex_*
+#include <time.h> // clock_gettime
+
+#define DEFAULT_THREADS 4 // Threads used by the stress tests
+#define DEFAULT_OPERATIONS 200000 // Operations per thread in each test
+#define MIN_CAPACITY 16 // Smallest table (always a power of two)
+#define MIGRATION_CHUNK 256 // Slots claimed at once by a thread helping a migration
+#define MAX_KEY (INT32_MAX - 1) // Keys are in [0, MAX_KEY]
+
+// Slot layout: bit 63 marks a frozen slot (already being migrated), bits 32..62 hold key + 1
+// (0 means the slot never had a key) and bits 0..31 hold the value
+#define FROZEN ((uint64_t)1 << 63)
+#define TOMBSTONE INT32_MIN // Value of a deleted key; the key keeps its slot until the next migration
+
+/*
+* One open-addressing table. Once a slot receives a key it keeps that key forever, so two
+* threads can never place the same key in two slots of the same table.
+*/
+typedef struct Table {
+	int capacity; // Power of two
+	_Atomic uint64_t* slots;
+	atomic_int used; // Slots holding a key (live or tombstone)
+	struct Table* _Atomic next; // Table this one is being migrated into, or NULL
+	atomic_int copy_index; // Next chunk to be claimed by a migrating thread
+	atomic_int copied; // Slots whose migration is complete
+} Table;
+
+/*
+* The map. Operations start at current; older tables stay linked through next from first
+* and are only freed by lf_map_destroy, since a slow thread may still be reading them.
+*/
+typedef struct {
+	Table* _Atomic current;
+	Table* first;
+	atomic_int size; // Live keys
+} LockFreeMap;
+
+/*
+* What an update does to the slot of its key.
+*/
+typedef enum { OP_GET, OP_PUT, OP_ADD, OP_REMOVE, OP_COPY } Operation;
+
+/*
+* Packs a key and a value into a slot word.
+*/
+static uint64_t pack(int key, int value) {
+	return ((uint64_t)(uint32_t)(key + 1) << 32) | (uint32_t)value;
+}
+
+/*
+* Key stored in a slot word, or -1 if the slot never had one.
+*/
+static int slot_key(uint64_t slot) {
+	return (int)((slot & ~FROZEN) >> 32) - 1;
+}
+
+/*
+* Value stored in a slot word.
+*/
+static int slot_value(uint64_t slot) {
+	return (int)(uint32_t)slot;
+}
+
+/*
+* Home slot of a key: the high bits of the MurmurHash3 finalizer, so that sequential keys
+* do not form long runs under linear probing.
+*/
+static int home_slot(const Table* t, int key) {
+	uint64_t x = (uint32_t)key;
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return (int)(x & (uint64_t)(t->capacity - 1));
+}
+
+/*
+* Allocates an empty table.
+* @param capacity Number of slots (a power of two).
+* @return Pointer to the table, or NULL if the allocation failed.
+*/
+static Table* table_create(int capacity) {
+	Table* t = malloc(sizeof(Table));
+	if (!t) return NULL;
+	t->slots = calloc(capacity, sizeof(uint64_t)); // Every slot starts as 0: no key, not frozen
+	if (!t->slots) {
+		free(t);
+		return NULL;
+	}
+	t->capacity = capacity;
+	atomic_init(&t->used, 0);
+	atomic_init(&t->next, NULL);
+	atomic_init(&t->copy_index, 0);
+	atomic_init(&t->copied, 0);
+	return t;
+}
+
+static bool table_update(LockFreeMap* map, Table* t, int key, Operation op, int argument, int* result);
+
+/*
+* Starts migrating a table if no thread has done so yet. The new table is sized for the
+* live keys only, so a table full of tombstones is rebuilt at the same size.
+* @return The table t migrates into.
+*/
+static Table* start_migration(LockFreeMap* map, Table* t) {
+	Table* next = atomic_load(&t->next);
+	if (next) return next;
+
+	long live = atomic_load(&map->size);
+	long capacity = MIN_CAPACITY;
+	while (capacity < 2 * (live + 1) || capacity < t->capacity / 2) capacity <<= 1;
+	if (capacity > (1 << 30)) capacity = 1 << 30;
+
+	Table* created = table_create((int)capacity);
+	if (!created) {
+		fprintf(stderr, "Memory allocation failed\n");
+		exit(1);
+	}
+	Table* expected = NULL;
+	if (atomic_compare_exchange_strong(&t->next, &expected, created))
+		return created;
+	free(created->slots); // Another thread won the race: use its table
+	free(created);
+	return expected;
+}
+
+/*
+* Freezes a slot of t and copies its key, if live, to the next table. Copying only claims
+* an absent key, so it is idempotent: any thread that finds a frozen slot can repeat it
+* before moving on, and a newer value already written to the next table is never lost.
+*/
+static void migrate_slot(LockFreeMap* map, Table* t, int index) {
+	uint64_t slot = atomic_load(&t->slots[index]);
+	while (!(slot & FROZEN) && !atomic_compare_exchange_weak(&t->slots[index], &slot, slot | FROZEN))
+		;
+	if (slot_key(slot) >= 0 && slot_value(slot) != TOMBSTONE)
+		table_update(map, atomic_load(&t->next), slot_key(slot), OP_COPY, slot_value(slot), NULL);
+}
+
+/*
+* Moves current forward past every table whose migration is complete.
+*/
+static void promote(LockFreeMap* map) {
+	Table* t = atomic_load(&map->current);
+	Table* next;
+	while ((next = atomic_load(&t->next)) && atomic_load(&t->copied) == t->capacity) {
+		if (atomic_compare_exchange_strong(&map->current, &t, next))
+			t = next;
+	}
+}
+
+/*
+* Migrates one chunk of t, if any chunk is still unclaimed. Every operation that finds a
+* migration in progress calls it, so the copy advances as long as any thread is running.
+*/
+static void help_migrate(LockFreeMap* map, Table* t) {
+	if (atomic_load(&t->copy_index) >= t->capacity) return; // Keeps copy_index from overflowing
+	int start = atomic_fetch_add(&t->copy_index, MIGRATION_CHUNK);
+	if (start >= t->capacity) return;
+
+	int end = start + MIGRATION_CHUNK < t->capacity ? start + MIGRATION_CHUNK : t->capacity;
+	for (int i = start; i < end; i++)
+		migrate_slot(map, t, i);
+	if (atomic_fetch_add(&t->copied, end - start) + (end - start) == t->capacity)
+		promote(map);
+}
+
+/*
+* Adds delta to value in 64 bits and saturates the sum to [INT32_MIN + 1, INT32_MAX]: the
+* addition never overflows, and its result is never TOMBSTONE, which would delete the key.
+* @param value Current value (0 for an absent key).
+* @param delta The increment.
+* @return The saturated sum.
+*/
+static int saturated_add(int value, int delta) {
+	int64_t sum = (int64_t)value + delta;
+	if (sum > INT32_MAX) return INT32_MAX;
+	if (sum <= TOMBSTONE) return TOMBSTONE + 1;
+	return (int)sum;
+}
+
+/*
+* Runs one operation on the table t, following the chain of newer tables when the key's
+* slot in t is already frozen.
+* @param map Pointer to the map.
+* @param t Table to start in.
+* @param key The key.
+* @param op What to do with the key's slot.
+* @param argument Value for OP_PUT and OP_COPY, increment for OP_ADD.
+* @param result Receives the value before the operation (OP_GET, OP_REMOVE) or after it (OP_ADD, OP_PUT); may be NULL.
+* @return true if the key was present (OP_GET, OP_REMOVE) or inserted (OP_COPY), true for OP_PUT and OP_ADD.
+*/
+static bool table_update(LockFreeMap* map, Table* t, int key, Operation op, int argument, int* result) {
+	while (true) {
+		Table* next = atomic_load(&t->next);
+		if (next && op != OP_COPY) help_migrate(map, t);
+
+		int index = home_slot(t, key);
+		bool moved = false;
+		for (int probes = 0; probes < t->capacity && !moved; probes++) {
+			uint64_t slot = atomic_load(&t->slots[index]);
+
+			while (true) {
+				int stored = slot_key(slot);
+
+				// A frozen slot with another key still belongs to the probe sequence. A frozen empty
+				// slot ends it, and a frozen slot with our key must reach the next table first:
+				// either way the operation continues there. A copy that finds its key here is
+				// stale (the key was already in this table, and may have been deleted since).
+				if (slot & FROZEN) {
+					if (stored >= 0 && stored != key) break;
+					if (stored == key) {
+						if (op == OP_COPY) return false;
+						migrate_slot(map, t, index);
+					}
+					moved = true;
+					break;
+				}
+
+				if (stored < 0) {
+					// The key is not in t: an empty slot always ends its probe sequence
+					if (op == OP_GET || op == OP_REMOVE) return false;
+
+					// During a migration new keys go to the next table; freezing the empty slot first
+					// closes the probe sequence in t, so no other thread can still add the key here
+					if (next || atomic_load(&t->used) + 1 > t->capacity / 4 * 3) {
+						next = start_migration(map, t);
+						if (atomic_compare_exchange_weak(&t->slots[index], &slot, FROZEN)) {
+							moved = true;
+							break;
+						}
+						continue; // Another thread changed the slot: look at it again
+					}
+
+					int inserted = op == OP_ADD ? saturated_add(0, argument) : argument;
+					if (atomic_compare_exchange_weak(&t->slots[index], &slot, pack(key, inserted))) {
+						atomic_fetch_add(&t->used, 1);
+						if (op != OP_COPY) atomic_fetch_add(&map->size, 1);
+						if (result) *result = inserted;
+						return true;
+					}
+					continue;
+				}
+
+				if (stored != key) break; // Someone else's key: probe the next slot
+
+				int value = slot_value(slot);
+				switch (op) {
+				case OP_COPY:
+					return false; // Already migrated (or written by a newer operation)
+				case OP_GET:
+					if (value == TOMBSTONE) return false;
+					if (result) *result = value;
+					return true;
+				case OP_REMOVE:
+					if (value == TOMBSTONE) return false;
+					if (atomic_compare_exchange_weak(&t->slots[index], &slot, pack(key, TOMBSTONE))) {
+						atomic_fetch_sub(&map->size, 1);
+						if (result) *result = value;
+						return true;
+					}
+					continue;
+				default: {
+					int updated = op == OP_PUT ? argument : saturated_add(value == TOMBSTONE ? 0 : value, argument);
+					if (atomic_compare_exchange_weak(&t->slots[index], &slot, pack(key, updated))) {
+						if (value == TOMBSTONE) atomic_fetch_add(&map->size, 1);
+						if (result) *result = updated;
+						return true;
+					}
+					continue;
+				}
+				}
+			}
+			index = (index + 1) & (t->capacity - 1);
+		}
+
+		// Every slot was probed without finding the key or a free slot: the table must grow
+		t = moved ? atomic_load(&t->next) : start_migration(map, t);
+	}
+}
+
+/*
+* Creates an empty map.
+* @param capacity Expected number of keys.
+* @return Pointer to the map, or NULL if the allocation failed.
+*/
+LockFreeMap* lf_map_create(int capacity) {
+	LockFreeMap* map = malloc(sizeof(LockFreeMap));
+	if (!map) return NULL;
+
+	int slots = MIN_CAPACITY;
+	while (slots < capacity * 2 && slots < (1 << 30)) slots <<= 1;
+	map->first = table_create(slots);
+	if (!map->first) {
+		free(map);
+		return NULL;
+	}
+	atomic_init(&map->current, map->first);
+	atomic_init(&map->size, 0);
+	return map;
+}
+
+/*
+* Frees the map and every table it ever used. No other thread may be using it.
+* @param map Pointer to the map.
+*/
+void lf_map_destroy(LockFreeMap* map) {
+	Table* t = map->first;
+	while (t) {
+		Table* next = atomic_load(&t->next);
+		free(t->slots);
+		free(t);
+		t = next;
+	}
+	free(map);
+}
+
+/*
+* Looks up a key.
+* @param map Pointer to the map.
+* @param key The key (0 to MAX_KEY).
+* @param value Receives the value if the key is present.
+* @return true if the key is present.
+*/
+bool lf_map_get(LockFreeMap* map, int key, int* value) {
+	if (key < 0 || key > MAX_KEY) return false;
+	return table_update(map, atomic_load(&map->current), key, OP_GET, 0, value);
+}
+
+/*
+* Inserts a key or replaces its value.
+* @param map Pointer to the map.
+* @param key The key (0 to MAX_KEY).
+* @param value The value (any int except INT32_MIN).
+* @return true on success, false if the key or the value is out of range.
+*/
+bool lf_map_put(LockFreeMap* map, int key, int value) {
+	if (key < 0 || key > MAX_KEY || value == TOMBSTONE) return false;
+	return table_update(map, atomic_load(&map->current), key, OP_PUT, value, NULL);
+}
+
+/*
+* Atomically adds delta to the value of a key, inserting it with value delta if absent.
+* The sum saturates at INT32_MAX and at INT32_MIN + 1 (INT32_MIN is reserved for deleted keys).
+* @param map Pointer to the map.
+* @param key The key (0 to MAX_KEY).
+* @param delta The increment.
+* @return The value after the addition.
+*/
+int lf_map_add(LockFreeMap* map, int key, int delta) {
+	int result = 0;
+	if (key >= 0 && key <= MAX_KEY)
+		table_update(map, atomic_load(&map->current), key, OP_ADD, delta, &result);
+	return result;
+}
+
+/*
+* Deletes a key, leaving a tombstone that the next migration discards.
+* @param map Pointer to the map.
+* @param key The key (0 to MAX_KEY).
+* @return true if the key was present.
+*/
+bool lf_map_remove(LockFreeMap* map, int key) {
+	if (key < 0 || key > MAX_KEY) return false;
+	return table_update(map, atomic_load(&map->current), key, OP_REMOVE, 0, NULL);
+}
+
+/*
+* Number of live keys (exact when no operation is running).
+*/
+int lf_map_size(LockFreeMap* map) {
+	return atomic_load(&map->size);
+}
+
+/*
+* Number of slots of the table new operations start in.
+*/
+int lf_map_capacity(LockFreeMap* map) {
+	return atomic_load(&map->current)->capacity;
+}
+
+/*
+* Returns a monotonic timestamp in nanoseconds.
+*/
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+* Returns the next number of a per-thread xorshift generator.
+*/
+static uint32_t next_random(uint32_t* state) {
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return *state = x;
+}
+
+/*
+* Arguments of one stress-test thread.
+*/
+typedef struct {
+	LockFreeMap* map;
+	pthread_mutex_t* lock; // When not NULL, every operation runs under this mutex
+	int id, threads, operations, keys;
+	int* counts; // Increments made by this thread to each key of the counter test
+	long errors;
+} Worker;
+
+/*
+* Ownership test: each thread inserts, overwrites, reads and deletes only the keys congruent
+* to its id, checking every answer against a private copy, while all threads share (and keep
+* resizing) the same tables.
+*/
+static void* ownership_worker(void* arg) {
+	Worker* w = arg;
+	int owned = w->keys / w->threads;
+	int* expected = malloc(owned * sizeof(int)); // TOMBSTONE marks a key this thread deleted
+	uint32_t rng = 2463534242u + w->id;
+	for (int i = 0; i < owned; i++) expected[i] = TOMBSTONE;
+
+	for (int op = 0; op < w->operations; op++) {
+		int slot = next_random(&rng) % owned;
+		int key = slot * w->threads + w->id;
+		int dice = next_random(&rng) % 4;
+		int value;
+
+		if (dice == 0) {
+			bool present = lf_map_remove(w->map, key);
+			if (present != (expected[slot] != TOMBSTONE)) w->errors++;
+			expected[slot] = TOMBSTONE;
+		} else if (dice == 1) {
+			bool present = lf_map_get(w->map, key, &value);
+			if (present != (expected[slot] != TOMBSTONE) || (present && value != expected[slot])) w->errors++;
+		} else {
+			expected[slot] = op;
+			lf_map_put(w->map, key, op);
+		}
+	}
+
+	for (int slot = 0; slot < owned; slot++) {
+		int value;
+		bool present = lf_map_get(w->map, slot * w->threads + w->id, &value);
+		if (present != (expected[slot] != TOMBSTONE) || (present && value != expected[slot])) w->errors++;
+	}
+	free(expected);
+	return NULL;
+}
+
+/*
+* Counter test: every thread increments random keys of a small, shared key set, so the
+* same slots are updated by all threads at once.
+*/
+static void* counter_worker(void* arg) {
+	Worker* w = arg;
+	uint32_t rng = 88675123u + w->id;
+	for (int op = 0; op < w->operations; op++) {
+		int key = next_random(&rng) % w->keys;
+		if (w->lock) pthread_mutex_lock(w->lock);
+		lf_map_add(w->map, key, 1);
+		if (w->lock) pthread_mutex_unlock(w->lock);
+		w->counts[key]++;
+	}
+	return NULL;
+}
+
+/*
+* Runs one test with the given number of threads.
+* @return Total errors reported by the threads.
+*/
+static long run_threads(void* (*body)(void*), LockFreeMap* map, pthread_mutex_t* lock, int threads, int operations, int keys, int** counts) {
+	pthread_t* ids = malloc(threads * sizeof(pthread_t));
+	Worker* workers = malloc(threads * sizeof(Worker));
+	long errors = 0;
+
+	for (int i = 0; i < threads; i++) {
+		workers[i] = (Worker){ map, lock, i, threads, operations, keys, counts ? counts[i] : NULL, 0 };
+		pthread_create(&ids[i], NULL, body, &workers[i]);
+	}
+	for (int i = 0; i < threads; i++) {
+		pthread_join(ids[i], NULL);
+		errors += workers[i].errors;
+	}
+
+	free(ids);
+	free(workers);
+	return errors;
+}
+
+/*
+* Counter test with and without a global mutex: checks that no increment is lost and
+* prints the throughput of both versions.
+* @return Number of keys whose final count is wrong.
+*/
+static long counter_test(int threads, int operations, int keys, bool with_mutex) {
+	LockFreeMap* map = lf_map_create(MIN_CAPACITY); // Starts small so that it resizes under contention
+	pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+	int** counts = malloc(threads * sizeof(int*));
+	for (int i = 0; i < threads; i++) counts[i] = calloc(keys, sizeof(int));
+
+	uint64_t start = now_ns();
+	run_threads(counter_worker, map, with_mutex ? &lock : NULL, threads, operations, keys, counts);
+	uint64_t elapsed = now_ns() - start;
+
+	long wrong = 0;
+	for (int key = 0; key < keys; key++) {
+		int total = 0, value = 0;
+		for (int i = 0; i < threads; i++) total += counts[i][key];
+		lf_map_get(map, key, &value);
+		if (value != total) wrong++;
+	}
+
+	printf("%-22s %10.2f Mops/s, %ld wrong counters\n", with_mutex ? "counter map (mutex)" : "counter map (lock-free)",
+		(double)threads * operations / (elapsed / 1e3), wrong);
+
+	for (int i = 0; i < threads; i++) free(counts[i]);
+	free(counts);
+	lf_map_destroy(map);
+	return wrong;
+}
+
+/*
+* Main function of the program.
+* @param argc Number of command-line arguments.
+* @param argv Number of threads and operations per thread.
+* @return Program exit status (0 = every check passed).
+*/
+int main(int argc, char* argv[]) {
+	int threads = argc > 1 ? atoi(argv[1]) : DEFAULT_THREADS;
+	int operations = argc > 2 ? atoi(argv[2]) : DEFAULT_OPERATIONS;
+	if (threads <= 0 || operations <= 0) {
+		printf("Usage: %s [threads] [operations per thread]\n", argv[0]);
+		return 1;
+	}
+
+	printf("Stress tests with %d threads and %d operations per thread\n\n", threads, operations);
+
+	// Ownership test: shared tables, private keys; starts at the minimum capacity
+	LockFreeMap* map = lf_map_create(MIN_CAPACITY);
+	long errors = run_threads(ownership_worker, map, NULL, threads, operations, threads * 50000, NULL);
+	printf("%-22s %ld errors, %d live keys, %d slots\n", "insert/get/delete", errors, lf_map_size(map), lf_map_capacity(map));
+	lf_map_destroy(map);
+
+	// Counter test: 1024 hot keys shared by every thread
+	errors += counter_test(threads, operations, 1024, false);
+	errors += counter_test(threads, operations, 1024, true);
+
+	printf("\n%s\n", errors == 0 ? "All checks passed." : "Some checks FAILED.");
+	return errors == 0 ? 0 : 1;
+}
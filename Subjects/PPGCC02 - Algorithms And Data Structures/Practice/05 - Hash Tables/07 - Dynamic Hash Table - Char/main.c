@@ -0,0 +1,417 @@
+/*
+ * Description: This program implements a dynamic string-keyed hash table for symbol tables
+ * with millions of identifiers. Each key is hashed once per operation: the full 64-bit hash is
+ * stored next to the key pointer in the slot, so probing compares hashes and only touches the
+ * key bytes when the hashes match, and growing the table never rehashes a string. The key
+ * bytes are interned in a bump arena (no malloc per key) and the table doubles its capacity,
+ * a power of two, whenever the occupied slots pass the maximum load factor.
+ * Author: Breno Farias da Silva.
+ * Date: 07/06/2025.
+ */
+
+// Compile: gcc main.c -o main
+// Run: ./main
+
+#include <stdint.h> // uint64_t
+#include <stdio.h> // printf, snprintf
+#include <stdlib.h> // malloc, calloc, free
+#include <string.h> // strlen, memcpy, strcmp
+#include <time.h> // clock_gettime
+
+#define INITIAL_CAPACITY 16 // Initial number of slots (power of two)
+#define MAX_LOAD 0.75 // Maximum fraction of used slots (live keys plus tombstones)
+#define ARENA_CHUNK (64 * 1024) // Minimum size of an arena chunk, in bytes
+#define IDENTIFIERS 1000000 // Keys used by the symbol table benchmark
+
+/*
+ * Chunk of the key arena. Chunks are never moved, so an interned key keeps its address.
+ */
+typedef struct Chunk {
+	struct Chunk* next; // Next chunk of the arena
+	size_t size; // Bytes available in data
+	char data[];
+} Chunk;
+
+/*
+ * Bump allocator holding the bytes of every interned key.
+ */
+typedef struct {
+	Chunk* first; // First chunk (kept after a clear and reused in order)
+	Chunk* current; // Chunk the next key is copied to
+	size_t used; // Bytes already used in the current chunk
+	size_t total; // Bytes handed out by the arena
+} Arena;
+
+/*
+ * Slot of the table: the full hash of the key and a pointer to its bytes in the arena.
+ */
+typedef struct {
+	uint64_t hash; // Full 64-bit hash of the key
+	const char* key; // NULL if empty, DELETED if removed, otherwise the interned key
+} Slot;
+
+/*
+ * Hash table structure with open addressing (linear probing).
+ */
+typedef struct {
+	Slot* slots;
+	size_t capacity; // Number of slots (power of two)
+	size_t count; // Live keys
+	size_t used; // Live keys plus tombstones
+	size_t probes; // Slots inspected by find_slot, for the statistics
+	size_t searches; // Searches performed, for the statistics
+	Arena arena;
+} HashTable;
+
+/*
+ * Marker of a deleted slot: keeps the probe sequences of other keys intact.
+ */
+static const char deleted_marker;
+#define DELETED (&deleted_marker)
+
+/*
+* Hash function: 64-bit FNV-1a followed by the MurmurHash3 finalizer, so that the low bits used
+* to pick the slot depend on every byte of the key.
+* @param str The input string.
+* @param length Output: length of the string.
+* @return The computed 64-bit hash.
+*/
+uint64_t hash_string(const char* str, size_t* length) {
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	const char* p = str;
+	while (*p) {
+		hash ^= (unsigned char)*p++;
+		hash *= 0x100000001b3ULL;
+	}
+	*length = (size_t)(p - str);
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+/*
+ * Copies a key into the arena, opening a new chunk only when the current one is full.
+ * @param arena Pointer to the arena.
+ * @param key The string key.
+ * @param length Length of the key.
+ * @return Pointer to the interned copy, or NULL if the allocation fails.
+ */
+const char* arena_copy(Arena* arena, const char* key, size_t length) {
+	size_t need = length + 1;
+	if (arena->current == NULL || arena->used + need > arena->current->size) {
+		if (arena->current != NULL && arena->current->next != NULL && need <= arena->current->next->size) {
+			arena->current = arena->current->next; // Chunk kept by a previous clear
+		} else {
+			size_t size = need > ARENA_CHUNK ? need : ARENA_CHUNK;
+			Chunk* chunk = (Chunk*)malloc(sizeof(Chunk) + size);
+			if (chunk == NULL)
+				return NULL;
+			chunk->size = size;
+			if (arena->current == NULL) {
+				chunk->next = NULL;
+				arena->first = chunk;
+			} else {
+				chunk->next = arena->current->next;
+				arena->current->next = chunk;
+			}
+			arena->current = chunk;
+		}
+		arena->used = 0;
+	}
+	char* copy = arena->current->data + arena->used;
+	memcpy(copy, key, need);
+	arena->used += need;
+	arena->total += need;
+	return copy;
+}
+
+/*
+* Initializes the hash table.
+* @param table Pointer to the hash table.
+* @return 1 if successful, 0 if the allocation fails.
+*/
+int initialize_table(HashTable* table) {
+	table->slots = (Slot*)calloc(INITIAL_CAPACITY, sizeof(Slot));
+	table->capacity = INITIAL_CAPACITY;
+	table->count = 0;
+	table->used = 0;
+	table->probes = 0;
+	table->searches = 0;
+	table->arena = (Arena){NULL, NULL, 0, 0};
+	return table->slots != NULL;
+}
+
+/*
+ * Finds the slot of a key, or the slot where it would be inserted.
+ * @param table Pointer to the hash table.
+ * @param key The string key.
+ * @param hash Hash of the key.
+ * @param insert_at Output: first empty or deleted slot of the probe sequence (may be NULL).
+ * @return Index of the key, or -1 if absent.
+ */
+long find_slot(HashTable* table, const char* key, uint64_t hash, size_t* insert_at) {
+	size_t mask = table->capacity - 1;
+	size_t index = hash & mask;
+	size_t free_slot = (size_t)-1;
+	for (size_t i = 0; i < table->capacity; i++, index = (index + 1) & mask) {
+		Slot* slot = &table->slots[index];
+		table->probes++;
+		if (slot->key == NULL) {
+			if (free_slot == (size_t)-1)
+				free_slot = index;
+			break;
+		}
+		if (slot->key == DELETED) {
+			if (free_slot == (size_t)-1)
+				free_slot = index;
+		} else if (slot->hash == hash && strcmp(slot->key, key) == 0) {
+			return (long)index;
+		}
+	}
+	if (insert_at != NULL)
+		*insert_at = free_slot;
+	return -1;
+}
+
+/*
+ * Moves every live key to a new slot array, using the stored hashes (no string is rehashed).
+ * Tombstones are dropped; the capacity doubles only if the live keys alone need it.
+ * @param table Pointer to the hash table.
+ * @return 1 if successful, 0 if the allocation fails.
+ */
+int resize_table(HashTable* table) {
+	size_t capacity = table->capacity;
+	if (table->count + 1 > capacity * MAX_LOAD / 2)
+		capacity *= 2;
+	Slot* slots = (Slot*)calloc(capacity, sizeof(Slot));
+	if (slots == NULL)
+		return 0;
+
+	size_t mask = capacity - 1;
+	for (size_t i = 0; i < table->capacity; i++) {
+		Slot* slot = &table->slots[i];
+		if (slot->key == NULL || slot->key == DELETED)
+			continue;
+		size_t index = slot->hash & mask;
+		while (slots[index].key != NULL)
+			index = (index + 1) & mask;
+		slots[index] = *slot;
+	}
+	free(table->slots);
+	table->slots = slots;
+	table->capacity = capacity;
+	table->used = table->count;
+	return 1;
+}
+
+/*
+ * Inserts a key (if absent) and returns its interned copy. Equal strings always get the same
+ * pointer, so the callers can compare interned identifiers by address.
+ * @param table Pointer to the hash table.
+ * @param key The string key to intern.
+ * @param inserted Output: 1 if the key was new, 0 if it already existed (may be NULL).
+ * @return Pointer to the interned key, or NULL if the allocation fails.
+ */
+const char* intern_key(HashTable* table, const char* key, int* inserted) {
+	size_t length;
+	uint64_t hash = hash_string(key, &length);
+	size_t insert_at;
+	long found = find_slot(table, key, hash, &insert_at);
+	if (inserted != NULL)
+		*inserted = 0;
+	if (found != -1)
+		return table->slots[found].key;
+
+	if (table->slots[insert_at].key == NULL && table->used + 1 > table->capacity * MAX_LOAD) {
+		if (!resize_table(table))
+			return NULL;
+		find_slot(table, key, hash, &insert_at);
+	}
+
+	const char* copy = arena_copy(&table->arena, key, length);
+	if (copy == NULL)
+		return NULL;
+	if (table->slots[insert_at].key == NULL)
+		table->used++;
+	table->slots[insert_at] = (Slot){hash, copy};
+	table->count++;
+	if (inserted != NULL)
+		*inserted = 1;
+	return copy;
+}
+
+/*
+* Inserts a key into the hash table.
+* @param table Pointer to the hash table.
+* @param key The string key to insert.
+* @return 1 if inserted, 0 if it already exists or the allocation fails.
+*/
+int insert_key(HashTable* table, const char* key) {
+	int inserted;
+	return intern_key(table, key, &inserted) != NULL && inserted;
+}
+
+/*
+* Searches for a key in the hash table.
+* @param table Pointer to the hash table.
+* @param key The string key to search.
+* @return Index of the key if found, -1 otherwise.
+*/
+long search_key(HashTable* table, const char* key) {
+	size_t length;
+	table->searches++;
+	return find_slot(table, key, hash_string(key, &length), NULL);
+}
+
+/*
+* Deletes a key from the table. Its bytes stay in the arena until the table is cleared, so
+* pointers returned by intern_key remain valid.
+* @param table Pointer to the hash table.
+* @param key The string key to delete.
+* @return 1 if deleted, 0 if not found.
+*/
+int delete_key(HashTable* table, const char* key) {
+	size_t length;
+	long index = find_slot(table, key, hash_string(key, &length), NULL);
+	if (index == -1)
+		return 0;
+	table->slots[index].key = DELETED;
+	table->count--;
+	return 1;
+}
+
+/*
+* Clears the hash table. The arena chunks are kept and reused by the next insertions.
+* @param table Pointer to the hash table.
+*/
+void clear_table(HashTable* table) {
+	memset(table->slots, 0, table->capacity * sizeof(Slot));
+	table->count = 0;
+	table->used = 0;
+	table->arena.current = table->arena.first;
+	table->arena.used = 0;
+	table->arena.total = 0;
+}
+
+/*
+* Frees all memory used by the hash table.
+* @param table Pointer to the hash table.
+*/
+void free_table(HashTable* table) {
+	Chunk* chunk = table->arena.first;
+	while (chunk != NULL) {
+		Chunk* temp = chunk;
+		chunk = chunk->next;
+		free(temp);
+	}
+	free(table->slots);
+}
+
+/*
+* Prints the current state of the hash table.
+* @param table Pointer to the hash table.
+*/
+void print_table(HashTable* table) {
+	for (size_t i = 0; i < table->capacity; i++) {
+		const char* key = table->slots[i].key;
+		if (key == NULL)
+			printf("[%2zu] -\n", i);
+		else if (key == DELETED)
+			printf("[%2zu] *\n", i);
+		else
+			printf("[%2zu] %s (hash %016llx)\n", i, key, (unsigned long long)table->slots[i].hash);
+	}
+}
+
+/*
+ * Returns the current time in seconds.
+ * @return Monotonic time in seconds.
+ */
+double now_seconds() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Interns a million generated identifiers, then looks all of them up again.
+ */
+void symbol_table_benchmark() {
+	HashTable table;
+	if (!initialize_table(&table))
+		return;
+
+	char name[32];
+	double start = now_seconds();
+	for (int i = 0; i < IDENTIFIERS; i++) {
+		snprintf(name, sizeof(name), "identifier_%d", i);
+		insert_key(&table, name);
+	}
+	double inserted = now_seconds();
+
+	table.probes = 0; // Count only the slots inspected by the searches below
+	table.searches = 0;
+	int found = 0;
+	for (int i = 0; i < IDENTIFIERS; i++) {
+		snprintf(name, sizeof(name), "identifier_%d", i);
+		found += search_key(&table, name) != -1;
+	}
+	for (int i = 0; i < IDENTIFIERS; i++) {
+		snprintf(name, sizeof(name), "missing_%d", i);
+		found += search_key(&table, name) != -1;
+	}
+	double searched = now_seconds();
+
+	printf("\n=== Symbol table with %d identifiers ===\n", IDENTIFIERS);
+	printf("Insert: %.3f s, %d hits + %d misses: %.3f s\n", inserted - start, IDENTIFIERS, IDENTIFIERS, searched - inserted);
+	printf("Found: %d, capacity: %zu, load factor: %.2f\n", found, table.capacity, (double)table.count / table.capacity);
+	printf("Arena bytes: %zu, slot bytes: %zu\n", table.arena.total, table.capacity * sizeof(Slot));
+	printf("Average slots inspected per search: %.2f\n", (double)table.probes / (table.searches ? table.searches : 1));
+
+	free_table(&table);
+}
+
+int main() {
+	char* keys[] = {"apple", "banana", "grape", "orange", "lemon", "melon", "berry", "kiwi", "mango", "pear",
+		"cherry", "peach", "plum", "fig", "lime"};
+	int num_keys = sizeof(keys) / sizeof(char*);
+
+	HashTable table;
+	if (!initialize_table(&table))
+		return 1;
+
+	for (int i = 0; i < num_keys; i++)
+		insert_key(&table, keys[i]);
+
+	printf("\n=== Hash Table (%zu keys, %zu slots) ===\n", table.count, table.capacity);
+	print_table(&table);
+
+	char* test_keys[] = {"grape", "pineapple"};
+	for (int t = 0; t < 2; t++) {
+		long found_index = search_key(&table, test_keys[t]);
+		if (found_index != -1)
+			printf("Key %s found at index %ld.\n", test_keys[t], found_index);
+		else
+			printf("Key %s not found.\n", test_keys[t]);
+	}
+
+	char buffer[] = "lemon";
+	printf("Interned \"%s\" is the same pointer: %s\n", buffer, intern_key(&table, buffer, NULL) == intern_key(&table, "lemon", NULL) ? "yes" : "no");
+
+	char* del_key = "orange";
+	if (delete_key(&table, del_key))
+		printf("Key %s deleted successfully.\n", del_key);
+
+	printf("Table after deletion:\n");
+	print_table(&table);
+
+	clear_table(&table);
+	printf("Table cleared (%zu keys).\n", table.count);
+	free_table(&table);
+
+	symbol_table_benchmark();
+	return 0;
+}
@@ -0,0 +1,727 @@
+/*
+* Description: This program builds a minimal perfect hash function (MPHF) for a static set of
+* integer keys, in the style of PTHash: the n keys are mapped to the slots 0..n-1 with no
+* collisions, so a table built with it answers every lookup with a single slot access and no
+* probing or empty-slot checks. Keys are split into buckets and each bucket gets a small
+* "pilot" value chosen so that all of its keys land on free slots; only the bit-packed pilots
+* (plus a short remap array) are stored, about 3 bits per key. Large key sets are split into
+* partitions built in parallel by several threads, and the structure is saved to and loaded
+* from a file as a flat array of words.
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+// Compile: gcc -Wall -O2 -pthread main.c -o main
+// Run: ./main [keys] [threads]
+
+#include <stdio.h> // printf, fopen, fwrite, fread
+#include <stdlib.h> // malloc, calloc, free, atoi
+#include <stdint.h> // uint64_t, uint32_t
+#include <stdbool.h> // bool
+#include <string.h> // memcmp, memset
+#include <stdatomic.h> // atomic_int
+#include <pthread.h> // pthread_create, pthread_join
+#include <time.h> // clock_gettime
+
+#define DEFAULT_KEYS 10000000 // Keys of the large benchmark set
+#define DEFAULT_THREADS 4 // Threads used by the parallel build
+#define MAX_THREADS 64
+#define PARTITION_KEYS (1 << 18) // Average keys per partition
+#define BUCKET_FACTOR 3.5 // Buckets per partition: BUCKET_FACTOR * n / log2(n)
+#define LOAD_FACTOR 0.98 // Keys per slot before the remap (slots n..m-1 are remapped)
+#define DENSE_KEYS 0.6 // Fraction of the keys sent to the dense buckets...
+#define DENSE_BUCKETS 0.3 // ...which are this fraction of the buckets (bigger buckets are placed first)
+#define MAX_PILOT (1u << 24) // Pilots tried for one bucket before the partition is rebuilt with another seed
+#define MAX_ATTEMPTS 16 // Seeds tried for one partition
+#define FILE_MAGIC "MPHF0001"
+
+/*
+* Parameters of one partition. A lookup reads its partition, one pilot and, only for keys that
+* land on the remapped slots, one remap entry.
+*/
+typedef struct {
+	uint64_t seed; // Seed of the bucket and position hashes of this partition
+	uint64_t first; // Global index of the partition's slot 0
+	uint64_t pilot_offset; // Bit offset of the pilots in the bit array
+	uint64_t remap_offset; // Bit offset of the remap entries in the bit array
+	uint32_t n; // Keys of the partition
+	uint32_t m; // Slots of the partition before the remap (m >= n)
+	uint32_t buckets; // Number of buckets
+	uint32_t dense; // Number of dense buckets
+	uint8_t pilot_width; // Bits per pilot
+	uint8_t remap_width; // Bits per remap entry
+	uint8_t padding[6];
+} Partition;
+
+/*
+* Minimal perfect hash function: slot(key) is in [0, n) and is different for every key of the set.
+*/
+typedef struct {
+	uint64_t seed; // Global seed (partition choice)
+	uint64_t n; // Number of keys
+	uint64_t parts; // Number of partitions
+	uint64_t words; // Size of bits, in 64-bit words
+	Partition* part;
+	uint64_t* bits; // Pilots and remap entries of every partition, bit-packed
+} Mphf;
+
+/*
+* Result of building one partition, before the bits are packed.
+*/
+typedef struct {
+	uint32_t* pilots; // One per bucket
+	uint32_t* remap; // One per slot in [n, m): free slot below n for the keys placed there
+	int status; // 0 ok, -1 duplicate key, -2 out of memory or no pilot found
+} PartitionResult;
+
+/*
+* State shared by the build threads.
+*/
+typedef struct {
+	Mphf* mphf;
+	const int* keys;
+	uint64_t n;
+	int* scattered; // Keys grouped by partition
+	uint64_t* counts; // counts[t * parts + p]: keys of thread t's slice in partition p
+	PartitionResult* results;
+	atomic_int next_part; // Next partition to be claimed by a thread
+	int threads;
+} Build;
+
+typedef struct {
+	Build* build;
+	int id;
+} Worker;
+
+/*
+* 64-bit mixer (splitmix64 finalizer). It is a bijection, so different inputs never collide.
+*/
+static uint64_t mix64(uint64_t x) {
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
+/*
+* Maps a 64-bit hash to [0, range) with a multiplication instead of a division.
+*/
+static uint64_t reduce(uint64_t hash, uint64_t range) {
+	return (uint64_t)(((__uint128_t)hash * range) >> 64);
+}
+
+/*
+* Returns the current time in seconds.
+*/
+static double now_seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+* Number of bits needed to store values up to max (at least 1).
+*/
+static int bit_width(uint32_t max) {
+	int width = 1;
+	while (width < 32 && (max >> width) != 0)
+		width++;
+	return width;
+}
+
+/*
+* Reads a value of width bits at a bit offset (the array has one padding word at the end).
+*/
+static uint32_t bits_get(const uint64_t* bits, uint64_t offset, int width) {
+	uint64_t word = offset >> 6;
+	int shift = (int)(offset & 63);
+	uint64_t value = bits[word] >> shift;
+	if (shift + width > 64)
+		value |= bits[word + 1] << (64 - shift);
+	return (uint32_t)(value & ((1ULL << width) - 1));
+}
+
+/*
+* Writes a value of width bits at a bit offset (the bits must still be zero).
+*/
+static void bits_set(uint64_t* bits, uint64_t offset, int width, uint32_t value) {
+	uint64_t word = offset >> 6;
+	int shift = (int)(offset & 63);
+	bits[word] |= (uint64_t)value << shift;
+	if (shift + width > 64)
+		bits[word + 1] |= (uint64_t)value >> (64 - shift);
+}
+
+/*
+* Hash of a key, which also chooses its partition.
+*/
+static uint64_t key_hash(const Mphf* mphf, int key) {
+	return mix64((uint64_t)(uint32_t)key ^ mphf->seed);
+}
+
+static uint64_t partition_of(const Mphf* mphf, uint64_t hash) {
+	return reduce(hash, mphf->parts);
+}
+
+/*
+* Bucket of a key within its partition: DENSE_KEYS of the keys go to the first DENSE_BUCKETS
+* of the buckets, so that there are a few big buckets (placed first, while the table is empty)
+* and many small ones.
+*/
+static uint32_t bucket_of(const Partition* part, uint64_t bucket_hash) {
+	if ((uint32_t)bucket_hash < (uint32_t)(DENSE_KEYS * 4294967296.0))
+		return (uint32_t)reduce(bucket_hash, part->dense);
+	return part->dense + (uint32_t)reduce(bucket_hash, part->buckets - part->dense);
+}
+
+/*
+* Hash of a pilot, combined with the position hash of each key of its bucket.
+*/
+static uint64_t pilot_hash(uint32_t pilot) {
+	return mix64(pilot + 0x9e3779b97f4a7c15ULL);
+}
+
+/*
+* Slot of a key in its partition, before the remap.
+*/
+static uint32_t position_of(const Partition* part, uint64_t position_hash, uint64_t pilot_hash) {
+	return (uint32_t)reduce(position_hash ^ pilot_hash, part->m);
+}
+
+/*
+* Slot of a key: in [0, n) and unique for every key of the set. Keys outside the set get some
+* slot too, so a table indexed by the MPHF must store the key to check membership.
+* @param mphf Pointer to the MPHF.
+* @param key The integer key.
+* @return Slot of the key.
+*/
+uint64_t mphf_lookup(const Mphf* mphf, int key) {
+	uint64_t hash = key_hash(mphf, key);
+	const Partition* part = &mphf->part[partition_of(mphf, hash)];
+	if (part->n == 0)
+		return 0;
+	uint64_t bucket_hash = mix64(hash ^ part->seed);
+	uint32_t bucket = bucket_of(part, bucket_hash);
+	uint32_t pilot = bits_get(mphf->bits, part->pilot_offset + (uint64_t)bucket * part->pilot_width, part->pilot_width);
+	uint32_t position = position_of(part, mix64(bucket_hash), pilot_hash(pilot));
+	if (position >= part->n)
+		position = bits_get(mphf->bits, part->remap_offset + (uint64_t)(position - part->n) * part->remap_width, part->remap_width);
+	return part->first + position;
+}
+
+/*
+* Places the keys of one partition: buckets are processed from the biggest to the smallest, and
+* each one gets the first pilot that sends all of its keys to free slots.
+* A bucket with no valid pilot makes the whole partition restart with another seed.
+* @param part Partition parameters (n and first already set; the rest is filled here).
+* @param keys Keys of the partition.
+* @param mphf MPHF being built (global seed and partition count).
+* @param result Output: pilots and remap entries.
+*/
+static void build_partition(Partition* part, const int* keys, const Mphf* mphf, PartitionResult* result) {
+	uint32_t n = part->n;
+	result->pilots = NULL;
+	result->remap = NULL;
+	result->status = 0;
+	if (n == 0) {
+		part->m = part->buckets = part->dense = 0;
+		part->pilot_width = part->remap_width = 1;
+		return;
+	}
+
+	double log_n = 1;
+	while ((1ULL << (int)log_n) < n)
+		log_n++;
+	part->m = (uint32_t)(n / LOAD_FACTOR) + 1;
+	part->buckets = (uint32_t)(BUCKET_FACTOR * n / log_n) + 1;
+	part->dense = (uint32_t)(DENSE_BUCKETS * part->buckets) + 1;
+	if (part->dense >= part->buckets)
+		part->buckets = part->dense + 1;
+
+	uint32_t m = part->m, buckets = part->buckets;
+	uint64_t* hashes = malloc(sizeof(uint64_t) * n); // Position hash of each key, grouped by bucket
+	uint64_t* sorted = malloc(sizeof(uint64_t) * n);
+	uint32_t* bucket = malloc(sizeof(uint32_t) * n);
+	uint32_t* start = malloc(sizeof(uint32_t) * (buckets + 1));
+	uint32_t* order = malloc(sizeof(uint32_t) * buckets);
+	uint64_t* taken = malloc(sizeof(uint64_t) * (m / 64 + 1));
+	result->pilots = malloc(sizeof(uint32_t) * buckets);
+	result->remap = calloc(m - n + 1, sizeof(uint32_t));
+	if (!hashes || !sorted || !bucket || !start || !order || !taken || !result->pilots || !result->remap) {
+		result->status = -2;
+		goto done;
+	}
+
+	for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+		part->seed = mix64(mphf->seed + 0x632be59bd9b4e019ULL * (part->first + 1) + attempt);
+		result->status = 0;
+
+		// Counting sort of the keys by bucket
+		memset(start, 0, sizeof(uint32_t) * (buckets + 1));
+		for (uint32_t i = 0; i < n; i++) {
+			uint64_t bucket_hash = mix64(key_hash(mphf, keys[i]) ^ part->seed);
+			bucket[i] = bucket_of(part, bucket_hash);
+			hashes[i] = mix64(bucket_hash);
+			start[bucket[i] + 1]++;
+		}
+		uint32_t max_size = 0;
+		for (uint32_t b = 0; b < buckets; b++) {
+			if (start[b + 1] > max_size)
+				max_size = start[b + 1];
+			start[b + 1] += start[b];
+		}
+		for (uint32_t i = 0; i < n; i++)
+			sorted[start[bucket[i]]++] = hashes[i];
+		for (uint32_t b = buckets; b > 0; b--)
+			start[b] = start[b - 1];
+		start[0] = 0;
+
+		// Buckets by decreasing size (counting sort on the sizes)
+		uint32_t* by_size = calloc(max_size + 2, sizeof(uint32_t));
+		if (by_size == NULL) {
+			result->status = -2;
+			goto done;
+		}
+		for (uint32_t b = 0; b < buckets; b++)
+			by_size[max_size - (start[b + 1] - start[b]) + 1]++;
+		for (uint32_t s = 0; s <= max_size; s++)
+			by_size[s + 1] += by_size[s];
+		for (uint32_t b = 0; b < buckets; b++)
+			order[by_size[max_size - (start[b + 1] - start[b])]++] = b;
+		free(by_size);
+
+		memset(taken, 0, sizeof(uint64_t) * (m / 64 + 1));
+		for (uint32_t o = 0; o < buckets && result->status == 0; o++) {
+			uint32_t b = order[o];
+			uint32_t size = start[b + 1] - start[b];
+			const uint64_t* h = &sorted[start[b]];
+			result->pilots[b] = 0;
+			if (size == 0)
+				continue;
+
+			// The position hash is a bijection of the key: equal hashes in a bucket mean a repeated key
+			for (uint32_t i = 0; i < size && result->status == 0; i++)
+				for (uint32_t j = i + 1; j < size; j++)
+					if (h[i] == h[j])
+						result->status = -1;
+			if (result->status != 0)
+				break;
+
+			uint32_t pilot;
+			uint32_t positions[64];
+			for (pilot = 0; pilot < MAX_PILOT; pilot++) {
+				uint64_t hp = pilot_hash(pilot);
+				bool ok = size <= 64;
+				for (uint32_t i = 0; i < size && ok; i++) {
+					uint32_t p = position_of(part, h[i], hp);
+					if (taken[p >> 6] >> (p & 63) & 1)
+						ok = false;
+					for (uint32_t j = 0; j < i && ok; j++)
+						if (positions[j] == p)
+							ok = false;
+					positions[i] = p;
+				}
+				if (ok)
+					break;
+			}
+			if (pilot == MAX_PILOT) {
+				result->status = -2; // Retried with another seed
+				break;
+			}
+			for (uint32_t i = 0; i < size; i++)
+				taken[positions[i] >> 6] |= 1ULL << (positions[i] & 63);
+			result->pilots[b] = pilot;
+		}
+		if (result->status == -1)
+			break;
+		if (result->status != 0)
+			continue;
+
+		// Keys placed on slots n..m-1 are moved to the slots below n left free
+		uint32_t free_slot = 0;
+		for (uint32_t p = n; p < m; p++) {
+			if (!(taken[p >> 6] >> (p & 63) & 1))
+				continue;
+			while (taken[free_slot >> 6] >> (free_slot & 63) & 1)
+				free_slot++;
+			result->remap[p - n] = free_slot++;
+		}
+		break;
+	}
+
+	if (result->status == 0) {
+		uint32_t max_pilot = 0;
+		for (uint32_t b = 0; b < buckets; b++)
+			if (result->pilots[b] > max_pilot)
+				max_pilot = result->pilots[b];
+		part->pilot_width = (uint8_t)bit_width(max_pilot);
+		part->remap_width = (uint8_t)bit_width(n - 1);
+	}
+
+done:
+	free(hashes);
+	free(sorted);
+	free(bucket);
+	free(start);
+	free(order);
+	free(taken);
+}
+
+/*
+* Build phases run by every thread: counting the keys of each partition in the thread's slice,
+* scattering the slice to the partitions, and building the partitions claimed from a counter.
+*/
+static void* count_keys(void* arg) {
+	Worker* worker = (Worker*)arg;
+	Build* build = worker->build;
+	uint64_t parts = build->mphf->parts;
+	uint64_t from = build->n * worker->id / build->threads, to = build->n * (worker->id + 1) / build->threads;
+	uint64_t* counts = &build->counts[worker->id * parts];
+	for (uint64_t i = from; i < to; i++)
+		counts[partition_of(build->mphf, key_hash(build->mphf, build->keys[i]))]++;
+	return NULL;
+}
+
+static void* scatter_keys(void* arg) {
+	Worker* worker = (Worker*)arg;
+	Build* build = worker->build;
+	uint64_t parts = build->mphf->parts;
+	uint64_t from = build->n * worker->id / build->threads, to = build->n * (worker->id + 1) / build->threads;
+	uint64_t* next = &build->counts[worker->id * parts]; // Turned into write positions by the caller
+	for (uint64_t i = from; i < to; i++)
+		build->scattered[next[partition_of(build->mphf, key_hash(build->mphf, build->keys[i]))]++] = build->keys[i];
+	return NULL;
+}
+
+static void* build_partitions(void* arg) {
+	Build* build = ((Worker*)arg)->build;
+	int p;
+	while ((p = atomic_fetch_add(&build->next_part, 1)) < (int)build->mphf->parts) {
+		Partition* part = &build->mphf->part[p];
+		build_partition(part, &build->scattered[part->first], build->mphf, &build->results[p]);
+	}
+	return NULL;
+}
+
+/*
+* Runs one build phase on every thread.
+*/
+static void run_phase(Build* build, void* (*body)(void*)) {
+	pthread_t ids[MAX_THREADS];
+	Worker workers[MAX_THREADS];
+	for (int t = 0; t < build->threads; t++) {
+		workers[t] = (Worker){build, t};
+		pthread_create(&ids[t], NULL, body, &workers[t]);
+	}
+	for (int t = 0; t < build->threads; t++)
+		pthread_join(ids[t], NULL);
+}
+
+/*
+* Frees an MPHF.
+* @param mphf Pointer to the MPHF.
+*/
+void mphf_free(Mphf* mphf) {
+	if (mphf == NULL)
+		return;
+	free(mphf->part);
+	free(mphf->bits);
+	free(mphf);
+}
+
+/*
+* Builds the MPHF of a set of distinct keys.
+* @param keys Array of keys (must not contain repeated keys).
+* @param n Number of keys.
+* @param threads Threads used by the build.
+* @param seed Seed of the hash functions.
+* @return Pointer to the MPHF, or NULL if a key is repeated or memory is exhausted.
+*/
+Mphf* mphf_build(const int* keys, uint64_t n, int threads, uint64_t seed) {
+	if (threads < 1)
+		threads = 1;
+	if (threads > MAX_THREADS)
+		threads = MAX_THREADS;
+
+	Mphf* mphf = calloc(1, sizeof(Mphf));
+	if (mphf == NULL)
+		return NULL;
+	mphf->seed = mix64(seed);
+	mphf->n = n;
+	mphf->parts = n / PARTITION_KEYS + 1;
+
+	Build build = {mphf, keys, n, NULL, NULL, NULL, 0, threads};
+	mphf->part = calloc(mphf->parts, sizeof(Partition));
+	build.scattered = malloc(sizeof(int) * (n + 1));
+	build.counts = calloc((size_t)threads * mphf->parts, sizeof(uint64_t));
+	build.results = calloc(mphf->parts, sizeof(PartitionResult));
+	bool ok = mphf->part && build.scattered && build.counts && build.results;
+
+	if (ok) {
+		// Keys grouped by partition: each thread writes its slice to its own ranges
+		run_phase(&build, count_keys);
+		uint64_t position = 0;
+		for (uint64_t p = 0; p < mphf->parts; p++) {
+			mphf->part[p].first = position;
+			for (int t = 0; t < threads; t++) {
+				uint64_t count = build.counts[t * mphf->parts + p];
+				build.counts[t * mphf->parts + p] = position;
+				position += count;
+			}
+			mphf->part[p].n = (uint32_t)(position - mphf->part[p].first);
+		}
+		run_phase(&build, scatter_keys);
+		run_phase(&build, build_partitions);
+	}
+
+	// Packs the pilots and remap entries of every partition into one bit array
+	uint64_t total_bits = 0;
+	for (uint64_t p = 0; ok && p < mphf->parts; p++) {
+		Partition* part = &mphf->part[p];
+		if (build.results[p].status != 0) {
+			ok = false;
+			break;
+		}
+		part->pilot_offset = total_bits;
+		total_bits += (uint64_t)part->buckets * part->pilot_width;
+		part->remap_offset = total_bits;
+		total_bits += (uint64_t)(part->m - part->n) * part->remap_width;
+	}
+	if (ok) {
+		mphf->words = total_bits / 64 + 2; // One padding word for bits_get
+		mphf->bits = calloc(mphf->words, sizeof(uint64_t));
+		ok = mphf->bits != NULL;
+	}
+	for (uint64_t p = 0; ok && p < mphf->parts; p++) {
+		Partition* part = &mphf->part[p];
+		for (uint32_t b = 0; b < part->buckets; b++)
+			bits_set(mphf->bits, part->pilot_offset + (uint64_t)b * part->pilot_width, part->pilot_width, build.results[p].pilots[b]);
+		for (uint32_t i = 0; i < part->m - part->n; i++)
+			bits_set(mphf->bits, part->remap_offset + (uint64_t)i * part->remap_width, part->remap_width, build.results[p].remap[i]);
+	}
+
+	for (uint64_t p = 0; build.results && p < mphf->parts; p++) {
+		free(build.results[p].pilots);
+		free(build.results[p].remap);
+	}
+	free(build.results);
+	free(build.counts);
+	free(build.scattered);
+	if (!ok) {
+		mphf_free(mphf);
+		return NULL;
+	}
+	return mphf;
+}
+
+/*
+* Bits of the whole structure (partitions and bit array) per key.
+* @param mphf Pointer to the MPHF.
+* @return Bits per key.
+*/
+double mphf_bits_per_key(const Mphf* mphf) {
+	return mphf->n ? (mphf->words * 64.0 + mphf->parts * sizeof(Partition) * 8.0) / mphf->n : 0.0;
+}
+
+/*
+* Saves an MPHF to a file: a header, the partitions and the bit array, as they are in memory.
+* @param mphf Pointer to the MPHF.
+* @param path File name.
+* @return 1 if successful, 0 otherwise.
+*/
+int mphf_save(const Mphf* mphf, const char* path) {
+	FILE* file = fopen(path, "wb");
+	if (file == NULL)
+		return 0;
+	uint64_t header[4] = {mphf->seed, mphf->n, mphf->parts, mphf->words};
+	int ok = fwrite(FILE_MAGIC, 1, 8, file) == 8
+		&& fwrite(header, sizeof(header), 1, file) == 1
+		&& fwrite(mphf->part, sizeof(Partition), mphf->parts, file) == mphf->parts
+		&& fwrite(mphf->bits, sizeof(uint64_t), mphf->words, file) == mphf->words;
+	return fclose(file) == 0 && ok;
+}
+
+/*
+* Loads an MPHF saved by mphf_save.
+* @param path File name.
+* @return Pointer to the MPHF, or NULL if the file is missing or invalid.
+*/
+Mphf* mphf_load(const char* path) {
+	FILE* file = fopen(path, "rb");
+	if (file == NULL)
+		return NULL;
+	char magic[8];
+	uint64_t header[4];
+	Mphf* mphf = NULL;
+	if (fread(magic, 1, 8, file) == 8 && memcmp(magic, FILE_MAGIC, 8) == 0 && fread(header, sizeof(header), 1, file) == 1
+		&& header[2] >= 1 && header[2] <= header[1] / PARTITION_KEYS + 1 && header[3] >= 2)
+		mphf = calloc(1, sizeof(Mphf));
+	if (mphf != NULL) {
+		mphf->seed = header[0];
+		mphf->n = header[1];
+		mphf->parts = header[2];
+		mphf->words = header[3];
+		mphf->part = malloc(sizeof(Partition) * mphf->parts);
+		mphf->bits = malloc(sizeof(uint64_t) * mphf->words);
+		if (!mphf->part || !mphf->bits || fread(mphf->part, sizeof(Partition), mphf->parts, file) != mphf->parts
+			|| fread(mphf->bits, sizeof(uint64_t), mphf->words, file) != mphf->words) {
+			mphf_free(mphf);
+			mphf = NULL;
+		}
+	}
+	// Every bit offset read by a lookup must be inside the array, and every remap entry must
+	// point below n, so that a lookup never returns a slot outside [0, n)
+	for (uint64_t p = 0; mphf != NULL && p < mphf->parts; p++) {
+		const Partition* part = &mphf->part[p];
+		bool valid = part->m >= part->n && part->pilot_width >= 1 && part->pilot_width <= 32
+			&& part->remap_width >= 1 && part->remap_width <= 32 && part->first + part->n <= mphf->n
+			&& (part->n == 0 || (part->dense >= 1 && part->dense < part->buckets))
+			&& part->pilot_offset + (uint64_t)part->buckets * part->pilot_width <= (mphf->words - 1) * 64
+			&& part->remap_offset + (uint64_t)(part->m - part->n) * part->remap_width <= (mphf->words - 1) * 64;
+		for (uint32_t i = 0; valid && i < part->m - part->n; i++)
+			valid = bits_get(mphf->bits, part->remap_offset + (uint64_t)i * part->remap_width, part->remap_width) < part->n;
+		if (!valid) {
+			mphf_free(mphf);
+			mphf = NULL;
+		}
+	}
+	fclose(file);
+	return mphf;
+}
+
+/*
+* Static table indexed by an MPHF: one slot per key, holding the key to check membership.
+*/
+typedef struct {
+	Mphf* mphf;
+	int* table;
+} PerfectTable;
+
+/*
+* Searches for a key: one slot access, no probing.
+* @param table Pointer to the table.
+* @param key The key to search.
+* @return Index of the key if found, -1 otherwise.
+*/
+long search_key(const PerfectTable* table, int key) {
+	if (table->mphf->n == 0)
+		return -1;
+	uint64_t slot = mphf_lookup(table->mphf, key);
+	return table->table[slot] == key ? (long)slot : -1;
+}
+
+/*
+* Builds an MPHF over the keys of the static tables and searches it.
+*/
+void small_example(void) {
+	int keys[] = {18, 41, 22, 44, 59, 32, 31, 73, 26, 56};
+	int num_keys = sizeof(keys) / sizeof(int);
+
+	PerfectTable table = {mphf_build(keys, num_keys, 1, 42), malloc(sizeof(int) * num_keys)};
+	if (table.mphf == NULL || table.table == NULL) {
+		printf("Failed to build the MPHF\n");
+		return;
+	}
+	for (int i = 0; i < num_keys; i++)
+		table.table[mphf_lookup(table.mphf, keys[i])] = keys[i];
+
+	printf("\n=== Perfect Hash Table (%d keys, %d slots) ===\n", num_keys, num_keys);
+	for (int i = 0; i < num_keys; i++)
+		printf("[%2d] %d\n", i, table.table[i]);
+
+	int test_keys[] = {22, 100};
+	for (int t = 0; t < 2; t++) {
+		long found_index = search_key(&table, test_keys[t]);
+		if (found_index != -1)
+			printf("Key %d found at index %ld.\n", test_keys[t], found_index);
+		else
+			printf("Key %d not found.\n", test_keys[t]);
+	}
+
+	int repeated[] = {1, 2, 3, 2};
+	Mphf* invalid = mphf_build(repeated, 4, 1, 42);
+	printf("Build with a repeated key: %s\n", invalid == NULL ? "rejected" : "accepted");
+	mphf_free(invalid);
+
+	mphf_free(table.mphf);
+	free(table.table);
+}
+
+/*
+* Builds an MPHF over many distinct keys, checks that it is minimal and perfect, measures its
+* size and lookup time, and saves and reloads it.
+* @param n Number of keys.
+* @param threads Threads used by the build.
+*/
+void large_benchmark(uint64_t n, int threads) {
+	int* keys = malloc(sizeof(int) * n);
+	uint64_t* seen = calloc(n / 64 + 1, sizeof(uint64_t));
+	if (keys == NULL || seen == NULL) {
+		printf("Failed to allocate %llu keys\n", (unsigned long long)n);
+		free(keys);
+		free(seen);
+		return;
+	}
+	for (uint64_t i = 0; i < n; i++)
+		keys[i] = (int)((i * 0x9e3779b1u) & 0x7fffffff); // Odd multiplier: distinct keys modulo 2^31
+
+	printf("\n=== MPHF of %llu keys ===\n", (unsigned long long)n);
+	double start = now_seconds();
+	Mphf* mphf = mphf_build(keys, n, threads, 7);
+	double built = now_seconds();
+	if (mphf == NULL) {
+		printf("Failed to build the MPHF\n");
+		free(keys);
+		free(seen);
+		return;
+	}
+	printf("Build with %d thread(s): %.2f s, %llu partitions\n", threads, built - start, (unsigned long long)mphf->parts);
+	printf("Size: %.2f bits per key\n", mphf_bits_per_key(mphf));
+
+	uint64_t collisions = 0, checksum = 0;
+	start = now_seconds();
+	for (uint64_t i = 0; i < n; i++) {
+		uint64_t slot = mphf_lookup(mphf, keys[i]);
+		checksum += slot;
+		if (slot >= n || (seen[slot >> 6] >> (slot & 63) & 1))
+			collisions++;
+		else
+			seen[slot >> 6] |= 1ULL << (slot & 63);
+	}
+	double looked_up = now_seconds();
+	printf("Lookups: %.1f ns per key, slots out of range or repeated: %llu\n", (looked_up - start) * 1e9 / n, (unsigned long long)collisions);
+
+	const char* path = "mphf.dat";
+	Mphf* loaded = mphf_save(mphf, path) ? mphf_load(path) : NULL;
+	uint64_t loaded_checksum = 0;
+	for (uint64_t i = 0; loaded != NULL && i < n; i++)
+		loaded_checksum += mphf_lookup(loaded, keys[i]);
+	printf("Saved and reloaded from %s: %s\n", path, loaded != NULL && loaded_checksum == checksum ? "same slots" : "failed");
+	remove(path);
+
+	mphf_free(loaded);
+	mphf_free(mphf);
+	free(keys);
+	free(seen);
+}
+
+/*
+* Main function of the program.
+* @param argc Number of command-line arguments.
+* @param argv Array of command-line arguments.
+* @return Exit code.
+*/
+int main(int argc, char* argv[]) {
+	long long keys = argc > 1 ? atoll(argv[1]) : DEFAULT_KEYS;
+	int threads = argc > 2 ? atoi(argv[2]) : DEFAULT_THREADS;
+	if (keys < 1 || keys > 0x7fffffffLL || threads < 1 || threads > MAX_THREADS) {
+		printf("Usage: %s [keys (1 to 2^31 - 1)] [threads (1 to %d)]\n", argv[0], MAX_THREADS);
+		return 1;
+	}
+
+	small_example();
+	large_benchmark((uint64_t)keys, threads);
+	return 0;
+}
@@ -463,4 +463,103 @@ int bst_find_path(Node* root, ElementType data, ElementType path[], int max_leng
 	}
 
 	return 0; // If not found or exceeded max_length
-}
\ No newline at end of file
+}
+
+/*
+* Helper function: writes the subtree in order starting at array[index].
+* Returns the index after the last element written.
+*/
+static int to_array_from(Node* root, ElementType array[], int index) {
+	if (root == NULL) return index;
+	index = to_array_from(root->left, array, index);
+	array[index++] = root->data;
+	return to_array_from(root->right, array, index);
+}
+
+/*
+* Helper function: fills the Eytzinger subtree rooted at slot k with sorted[i..], in order.
+* Returns the index of the first sorted key not used.
+*/
+static int eytzinger_fill(BstFrozen* frozen, const ElementType sorted[], int i, int k) {
+	if (k > frozen->size) return i;
+	i = eytzinger_fill(frozen, sorted, i, 2 * k);
+	frozen->keys[k] = sorted[i];
+	frozen->ranks[k] = i;
+	return eytzinger_fill(frozen, sorted, i + 1, 2 * k + 1);
+}
+
+/*
+* Copies the keys of the tree into a frozen Eytzinger index.
+*/
+BstFrozen* bst_freeze(Node* root) {
+	int size = bst_size(root);
+	// aligned_alloc needs a size multiple of the alignment
+	size_t bytes = ((size + 1) * sizeof(ElementType) + 63) / 64 * 64;
+	BstFrozen* frozen = (BstFrozen*) malloc(sizeof(BstFrozen));
+	ElementType* sorted = (ElementType*) malloc((size + 1) * sizeof(ElementType));
+	if (frozen != NULL) {
+		frozen->keys = (ElementType*) aligned_alloc(64, bytes);
+		frozen->ranks = (int*) malloc((size + 1) * sizeof(int));
+	}
+	if (!frozen || !sorted || !frozen->keys || !frozen->ranks) {
+		fprintf(stderr, "Memory allocation failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	frozen->size = size;
+	to_array_from(root, sorted, 0);
+	eytzinger_fill(frozen, sorted, 0, 1);
+	free(sorted);
+	return frozen;
+}
+
+/*
+* Helper function: returns the slot of the smallest key >= data, or 0 if there is none.
+* Branchless descent with prefetching, as in avl.c of "Practice/07 - AVL Tree".
+*/
+static unsigned int frozen_lower_bound_slot(const BstFrozen* frozen, ElementType data) {
+	const ElementType* keys = frozen->keys;
+	unsigned int size = (unsigned int) frozen->size;
+	unsigned int k = 1;
+
+	while (k <= size) {
+		__builtin_prefetch(keys + 16 * k);
+		k = 2 * k + (keys[k] < data);
+	}
+	return k >> __builtin_ffs(~k);
+}
+
+/*
+* Checks if data is in the frozen index.
+*/
+bool bst_frozen_contains(const BstFrozen* frozen, ElementType data) {
+	unsigned int k = frozen_lower_bound_slot(frozen, data);
+	return k != 0 && frozen->keys[k] == data;
+}
+
+/*
+* Returns the smallest key >= data, or NULL.
+*/
+const ElementType* bst_frozen_lower_bound(const BstFrozen* frozen, ElementType data) {
+	unsigned int k = frozen_lower_bound_slot(frozen, data);
+	return k != 0 ? &frozen->keys[k] : NULL;
+}
+
+/*
+* Returns the number of keys smaller than data: the rank of the lower bound, or every key.
+*/
+int bst_frozen_rank(const BstFrozen* frozen, ElementType data) {
+	unsigned int k = frozen_lower_bound_slot(frozen, data);
+	return k != 0 ? frozen->ranks[k] : frozen->size;
+}
+
+/*
+* Frees the frozen index.
+*/
+void bst_frozen_destroy(BstFrozen** frozen) {
+	if (*frozen == NULL) return;
+	free((*frozen)->keys);
+	free((*frozen)->ranks);
+	free(*frozen);
+	*frozen = NULL;
+}
@@ -17,6 +17,16 @@ typedef struct Node {
 	struct Node* right;
 } Node;
 
+/*
+* Read-only index of a BST's keys in Eytzinger (BFS) order, laid out like the AvlFrozen
+* index of "Practice/07 - AVL Tree".
+*/
+typedef struct {
+	ElementType* keys; // keys[1..size]; keys[0] is unused
+	int* ranks; // ranks[k]: number of keys smaller than keys[k]
+	int size;
+} BstFrozen;
+
 /*
 * Creates an empty BST (NULL root).
 * return: NULL pointer representing an empty tree.
@@ -224,4 +234,43 @@ bool bst_is_balanced(Node* root);
 */
 int bst_find_path(Node* root, ElementType data, ElementType path[], int max_length);
 
+/*
+* Copies the keys of a BST into a frozen Eytzinger index. The tree is not changed,
+* and later changes to it are not seen by the index.
+* root: pointer to the root node of the tree.
+* return: pointer to the new frozen index.
+*/
+BstFrozen* bst_freeze(Node* root);
+
+/*
+* Checks if an element exists in a frozen index (branchless search).
+* frozen: pointer to the frozen index.
+* data: element to search for.
+* return: true if element exists, false otherwise.
+*/
+bool bst_frozen_contains(const BstFrozen* frozen, ElementType data);
+
+/*
+* Returns the smallest key of a frozen index that is greater than or equal to data.
+* frozen: pointer to the frozen index.
+* data: element to search for.
+* return: pointer to the key inside the index, or NULL if every key is smaller than data.
+*/
+const ElementType* bst_frozen_lower_bound(const BstFrozen* frozen, ElementType data);
+
+/*
+* Returns the rank of an element in a frozen index.
+* The rank is the number of keys smaller than the given data.
+* frozen: pointer to the frozen index.
+* data: element to find the rank for.
+* return: rank of the element (0-based).
+*/
+int bst_frozen_rank(const BstFrozen* frozen, ElementType data);
+
+/*
+* Frees a frozen index and sets its pointer to NULL.
+* frozen: pointer to the frozen index pointer.
+*/
+void bst_frozen_destroy(BstFrozen** frozen);
+
 #endif
@@ -115,6 +115,13 @@ int main(int argc, char *argv[]) {
 		printf("Element %d not found in BST.\n", target);
 	}
 
+	// Test bst_freeze: read-only Eytzinger index of the clone
+	BstFrozen* frozen = bst_freeze(clone);
+	const ElementType* bound = bst_frozen_lower_bound(frozen, 12);
+	printf("Frozen clone contains 15? %s\n", bst_frozen_contains(frozen, 15) ? "Yes" : "No");
+	printf("Frozen lower bound of 12: %d, rank of 12: %d\n", bound ? *bound : -1, bst_frozen_rank(frozen, 12));
+	bst_frozen_destroy(&frozen);
+
 	// Test bst_clear on clone
 	bst_clear(&clone);
 	printf("Cloned BST cleared. Is clone NULL? %s\n", clone == NULL ? "Yes" : "No");
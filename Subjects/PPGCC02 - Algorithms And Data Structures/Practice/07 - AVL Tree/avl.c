@@ -8,6 +8,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <pthread.h>
+
+/*
+* Bulk set operations only fork a branch when both inputs of the branch hold at least this many
+* nodes together: below it, creating a thread costs more than the branch.
+*/
+#define PARALLEL_GRAIN (1 << 14)
+
+/*
+* Nodes in the first slab of a tree's pool; each new slab doubles the previous one, up to
+* POOL_MAX_SLAB_NODES.
+*/
+#define POOL_SLAB_NODES 1024
+#define POOL_MAX_SLAB_NODES (1 << 20)
 
 /* 
 * Helper function: returns max between two integers.
@@ -25,6 +39,23 @@ static int height(Node* node) {
 	return node->height;
 }
 
+/*
+* Helper function: returns the number of nodes in the subtree of a node.
+* Returns 0 if node is NULL.
+*/
+static int size(Node* node) {
+	if (node == NULL) return 0;
+	return node->size;
+}
+
+/*
+* Helper function: recomputes the height and the subtree size of a node from its children.
+*/
+static void update(Node* node) {
+	node->height = max(height(node->left), height(node->right)) + 1;
+	node->size = size(node->left) + size(node->right) + 1;
+}
+
 /*
 * Creates an empty AVL tree (NULL root).
 * return: NULL pointer representing an empty tree.
@@ -46,6 +77,8 @@ static Node* create_node(ElementType data) {
 	node->left = NULL;
 	node->right = NULL;
 	node->height = 0; // leaf node height is 0
+	node->size = 1;
+	node->refs = 1;
 	return node;
 }
 
@@ -60,9 +93,9 @@ static Node* rotate_right(Node* y) {
 	x->right = y;
 	y->left = T2;
 
-	// Update heights
-	y->height = max(height(y->left), height(y->right)) + 1;
-	x->height = max(height(x->left), height(x->right)) + 1;
+	// Update heights and sizes (y is now the child of x)
+	update(y);
+	update(x);
 
 	return x;
 }
@@ -78,9 +111,9 @@ static Node* rotate_left(Node* x) {
 	y->left = x;
 	x->right = T2;
 
-	// Update heights
-	x->height = max(height(x->left), height(x->right)) + 1;
-	y->height = max(height(y->left), height(y->right)) + 1;
+	// Update heights and sizes (x is now the child of y)
+	update(x);
+	update(y);
 
 	return y;
 }
@@ -93,6 +126,32 @@ static int get_balance(Node* node) {
 	return height(node->left) - height(node->right);
 }
 
+/*
+* Updates a node whose subtrees differ in height by at most 2 and restores its balance
+* with a single or double rotation.
+* return: root of the rebalanced subtree.
+*/
+static Node* rebalance(Node* root) {
+	update(root);
+	int balance = get_balance(root);
+
+	// Left Left and Left Right Cases
+	if (balance > 1) {
+		if (get_balance(root->left) < 0)
+			root->left = rotate_left(root->left);
+		return rotate_right(root);
+	}
+
+	// Right Right and Right Left Cases
+	if (balance < -1) {
+		if (get_balance(root->right) > 0)
+			root->right = rotate_right(root->right);
+		return rotate_left(root);
+	}
+
+	return root;
+}
+
 /*
 * Inserts data into AVL tree and balances it.
 */
@@ -107,8 +166,8 @@ Node* avl_insert(Node* root, ElementType data) {
 	else
 		return root; // duplicate data not allowed
 
-	// Update height
-	root->height = 1 + max(height(root->left), height(root->right));
+	// Update height and size
+	update(root);
 
 	// Check balance
 	int balance = get_balance(root);
@@ -182,33 +241,8 @@ Node* avl_remove(Node* root, ElementType data) {
 	if (root == NULL)
 		return root;
 
-	// Update height
-	root->height = 1 + max(height(root->left), height(root->right));
-
-	// Check balance
-	int balance = get_balance(root);
-
-	// Left Left Case
-	if (balance > 1 && get_balance(root->left) >= 0)
-		return rotate_right(root);
-
-	// Left Right Case
-	if (balance > 1 && get_balance(root->left) < 0) {
-		root->left = rotate_left(root->left);
-		return rotate_right(root);
-	}
-
-	// Right Right Case
-	if (balance < -1 && get_balance(root->right) <= 0)
-		return rotate_left(root);
-
-	// Right Left Case
-	if (balance < -1 && get_balance(root->right) > 0) {
-		root->right = rotate_right(root->right);
-		return rotate_left(root);
-	}
-
-	return root;
+	// Update height and size, then restore balance
+	return rebalance(root);
 }
 
 /*
@@ -263,10 +297,10 @@ int avl_height(Node* root) {
 
 /*
 * Returns total number of nodes in the tree.
+* Each node stores the size of its subtree, so this is O(1).
 */
 int avl_size(Node* root) {
-	if (root == NULL) return 0;
-	return 1 + avl_size(root->left) + avl_size(root->right);
+	return size(root);
 }
 
 /*
@@ -360,15 +394,21 @@ Node* avl_predecessor(Node* root, ElementType data) {
 * If k is invalid (<=0 or > size), returns NULL.
 */
 Node* avl_select(Node* root, int k) {
-	if (root == NULL || k <= 0) return NULL;
-	int left_size = avl_size(root->left);
+	if (k <= 0 || k > size(root)) return NULL;
 
-	if (k == left_size + 1)
-		return root;
-	else if (k <= left_size)
-		return avl_select(root->left, k);
-	else
-		return avl_select(root->right, k - left_size - 1);
+	// One descent, guided by the left subtree sizes: O(log n)
+	while (root != NULL) {
+		int left_size = size(root->left);
+		if (k == left_size + 1)
+			return root;
+		if (k <= left_size) {
+			root = root->left;
+		} else {
+			k -= left_size + 1;
+			root = root->right;
+		}
+	}
+	return NULL;
 }
 
 /*
@@ -377,26 +417,107 @@ Node* avl_select(Node* root, int k) {
 * If the element does not exist, returns the rank it would have if it were inserted.
 */
 int avl_rank(Node* root, ElementType data) {
-	if (root == NULL) return 0;
-	if (data < root->data)
-		return avl_rank(root->left, data);
-	else if (data > root->data)
-		return 1 + avl_size(root->left) + avl_rank(root->right, data);
-	else
-		return avl_size(root->left);
+	int rank = 0;
+	while (root != NULL) {
+		if (data < root->data) {
+			root = root->left;
+		} else if (data > root->data) {
+			rank += size(root->left) + 1;
+			root = root->right;
+		} else {
+			return rank + size(root->left);
+		}
+	}
+	return rank;
 }
 
 /*
-* Converts the AVL tree to a sorted array.
-* The array must be pre-allocated with enough space.
+* Helper function: returns the number of elements less than or equal to data.
 */
-void avl_to_array(Node* root, ElementType array[]) {
-	static int index = 0;
-	if (root == NULL) return;
-	avl_to_array(root->left, array);
-	array[index++] = root->data;
-	avl_to_array(root->right, array);
-	if (root->height == 0) index = 0; // Reset after full traversal
+static int count_less_equal(Node* root, ElementType data) {
+	int count = 0;
+	while (root != NULL) {
+		if (data < root->data) {
+			root = root->left;
+		} else {
+			count += size(root->left) + 1;
+			root = root->right;
+		}
+	}
+	return count;
+}
+
+/*
+* Counts the elements in the closed interval [lo, hi].
+* Two rank descents, so O(log n) regardless of how many elements are in the interval.
+*/
+int avl_range_count(Node* root, ElementType lo, ElementType hi) {
+	if (lo > hi) return 0;
+	return count_less_equal(root, hi) - avl_rank(root, lo);
+}
+
+/*
+* Helper function: pushes node and its chain of left children (right children when iterating
+* in reverse). The top of the stack is then the next node to visit.
+*/
+static void iter_push_chain(AvlIter* it, Node* node) {
+	while (node != NULL) {
+		it->stack[it->depth++] = node;
+		node = it->reverse ? node->right : node->left;
+	}
+}
+
+/*
+* Starts an in-order iteration: the stack holds the path to the smallest (largest) node.
+*/
+void avl_iter_init(AvlIter* it, Node* root, bool reverse) {
+	it->root = root;
+	it->depth = 0;
+	it->reverse = reverse;
+	iter_push_chain(it, root);
+}
+
+/*
+* Restarts the iteration at data. Going down from the root, every node that comes at or after
+* data in the iteration order is pushed before moving towards data, so the stack ends up as
+* if the iteration had visited every node before data.
+*/
+void avl_iter_seek(AvlIter* it, ElementType data) {
+	Node* node = it->root;
+	it->depth = 0;
+	while (node != NULL) {
+		bool ahead = it->reverse ? node->data <= data : node->data >= data;
+		if (ahead) {
+			it->stack[it->depth++] = node;
+			node = it->reverse ? node->right : node->left;
+		} else {
+			node = it->reverse ? node->left : node->right;
+		}
+	}
+}
+
+/*
+* Pops the next node and pushes the chain of its other subtree.
+*/
+bool avl_iter_next(AvlIter* it, ElementType* data) {
+	if (it->depth == 0) return false;
+
+	Node* node = it->stack[--it->depth];
+	*data = node->data;
+	iter_push_chain(it, it->reverse ? node->left : node->right);
+	return true;
+}
+
+/*
+* Converts the AVL tree to a sorted array, writing at most cap elements.
+*/
+int avl_to_array(Node* root, ElementType out[], int cap) {
+	AvlIter it;
+	int count = 0;
+	avl_iter_init(&it, root, false);
+	while (count < cap && avl_iter_next(&it, &out[count]))
+		count++;
+	return count;
 }
 
 /*
@@ -412,7 +533,7 @@ Node* avl_from_sorted_array(ElementType array[], int start, int end) {
 	node->left = avl_from_sorted_array(array, start, mid - 1);
 	node->right = avl_from_sorted_array(array, mid + 1, end);
 
-	node->height = 1 + max(height(node->left), height(node->right));
+	update(node);
 
 	return node;
 }
@@ -484,6 +605,7 @@ Node* avl_clone(Node* root) {
 	new_node->left = avl_clone(root->left);
 	new_node->right = avl_clone(root->right);
 	new_node->height = root->height;
+	new_node->size = root->size;
 
 	return new_node;
 }
@@ -497,6 +619,16 @@ static bool is_bst_util(Node* node, ElementType min, ElementType max) {
 	return is_bst_util(node->left, min, node->data) && is_bst_util(node->right, node->data, max);
 }
 
+/*
+* Helper function to check that every stored height and subtree size matches the children.
+*/
+static bool is_consistent_util(Node* node) {
+	if (node == NULL) return true;
+	if (node->height != max(height(node->left), height(node->right)) + 1) return false;
+	if (node->size != size(node->left) + size(node->right) + 1) return false;
+	return is_consistent_util(node->left) && is_consistent_util(node->right);
+}
+
 /*
 * Validates if the AVL tree satisfies the BST properties and balance conditions.
 * root: pointer to the root node of the tree.
@@ -513,6 +645,10 @@ bool avl_is_valid(Node* root) {
 	if (!avl_is_balanced(root))
 		return false;
 
+	// Check stored heights and subtree sizes
+	if (!is_consistent_util(root))
+		return false;
+
 	return true;
 }
 
@@ -530,29 +666,8 @@ Node* avl_remove_min(Node* root) {
 	}
 	root->left = avl_remove_min(root->left);
 
-	// Update height
-	root->height = 1 + max(height(root->left), height(root->right));
-
-	// Balance node
-	int balance = get_balance(root);
-
-	if (balance > 1 && get_balance(root->left) >= 0)
-		return rotate_right(root);
-
-	if (balance > 1 && get_balance(root->left) < 0) {
-		root->left = rotate_left(root->left);
-		return rotate_right(root);
-	}
-
-	if (balance < -1 && get_balance(root->right) <= 0)
-		return rotate_left(root);
-
-	if (balance < -1 && get_balance(root->right) > 0) {
-		root->right = rotate_right(root->right);
-		return rotate_left(root);
-	}
-
-	return root;
+	// Update height and size, then restore balance
+	return rebalance(root);
 }
 
 /*
@@ -569,29 +684,8 @@ Node* avl_remove_max(Node* root) {
 	}
 	root->right = avl_remove_max(root->right);
 
-	// Update height
-	root->height = 1 + max(height(root->left), height(root->right));
-
-	// Balance node
-	int balance = get_balance(root);
-
-	if (balance > 1 && get_balance(root->left) >= 0)
-		return rotate_right(root);
-
-	if (balance > 1 && get_balance(root->left) < 0) {
-		root->left = rotate_left(root->left);
-		return rotate_right(root);
-	}
-
-	if (balance < -1 && get_balance(root->right) <= 0)
-		return rotate_left(root);
-
-	if (balance < -1 && get_balance(root->right) > 0) {
-		root->right = rotate_right(root->right);
-		return rotate_left(root);
-	}
-
-	return root;
+	// Update height and size, then restore balance
+	return rebalance(root);
 }
 
 /*
@@ -683,86 +777,624 @@ void avl_rotate_right(Node** root) {
 	*root = new_root;
 }
 
-// Helper: Merge two sorted arrays into one sorted array
-static void merge_sorted_arrays(ElementType arr1[], int size1, ElementType arr2[], int size2, ElementType dest[]) {
-	int i = 0, j = 0, k = 0;
-	while (i < size1 && j < size2) {
-		if (arr1[i] < arr2[j])
-			dest[k++] = arr1[i++];
-		else
-			dest[k++] = arr2[j++];
+/*
+* Joins two trees with a middle node, where every element of left < k->data < every element
+* of right. Descends the spine of the taller tree until the heights differ by at most one,
+* hangs k there and rebalances on the way back: O(|height(left) - height(right)|).
+* return: root of the joined tree.
+*/
+static Node* join(Node* left, Node* k, Node* right) {
+	if (height(left) > height(right) + 1) {
+		left->right = join(left->right, k, right);
+		return rebalance(left);
+	}
+	if (height(right) > height(left) + 1) {
+		right->left = join(left, k, right->left);
+		return rebalance(right);
+	}
+	k->left = left;
+	k->right = right;
+	update(k);
+	return k;
+}
+
+/*
+* Detaches the maximum node of a non-empty tree.
+* last: receives the detached node.
+* return: root of the remaining tree.
+*/
+static Node* split_last(Node* root, Node** last) {
+	if (root->right == NULL) {
+		*last = root;
+		return root->left;
+	}
+	root->right = split_last(root->right, last);
+	return rebalance(root);
+}
+
+/*
+* Joins two trees without a middle node, where every element of left < every element of right.
+* return: root of the joined tree.
+*/
+static Node* join2(Node* left, Node* right) {
+	if (left == NULL) return right;
+	Node* last;
+	left = split_last(left, &last);
+	return join(left, last, right);
+}
+
+/*
+* Splits a tree into the elements less than key and the elements greater than key,
+* joining the subtrees left on each side on the way back: O(log n).
+* return: the node holding key, detached as a single node, or NULL if key is not in the tree.
+*/
+static Node* split_node(Node* root, ElementType key, Node** leftTree, Node** rightTree) {
+	if (root == NULL) {
+		*leftTree = NULL;
+		*rightTree = NULL;
+		return NULL;
+	}
+
+	Node* left = root->left;
+	Node* right = root->right;
+	Node* middle;
+	Node* found;
+
+	if (key < root->data) {
+		found = split_node(left, key, leftTree, &middle);
+		*rightTree = join(middle, root, right);
+	} else if (key > root->data) {
+		found = split_node(right, key, &middle, rightTree);
+		*leftTree = join(left, root, middle);
+	} else {
+		*leftTree = left;
+		*rightTree = right;
+		root->left = NULL;
+		root->right = NULL;
+		update(root);
+		found = root;
 	}
-	while (i < size1) dest[k++] = arr1[i++];
-	while (j < size2) dest[k++] = arr2[j++];
+	return found;
+}
+
+/*
+* Joins two AVL trees with a new element between them.
+* Every element of left must be less than key, and every element of right greater.
+*/
+Node* avl_join(Node* left, ElementType key, Node* right) {
+	return join(left, create_node(key), right);
 }
 
 /*
 * Merges two AVL trees and returns the root of the merged AVL tree.
-* Approach:
-* 1. Convert both trees to sorted arrays.
-* 2. Merge arrays.
-* 3. Build AVL from merged sorted array.
+* Same as avl_union: no arrays are allocated, and duplicates are kept once.
 */
 Node* avl_merge(Node* tree1, Node* tree2) {
-	if (!tree1) return tree2;
-	if (!tree2) return tree1;
+	return avl_union(tree1, tree2);
+}
 
-	int size1 = avl_size(tree1);
-	int size2 = avl_size(tree2);
-	ElementType* arr1 = malloc(size1 * sizeof(ElementType));
-	ElementType* arr2 = malloc(size2 * sizeof(ElementType));
-	ElementType* merged = malloc((size1 + size2) * sizeof(ElementType));
+/*
+* Splits AVL tree into two trees: those less than key and those >= key.
+* Returns via pointers leftTree and rightTree, both balanced. The nodes of root are reused.
+*/
+void avl_split(Node* root, ElementType key, Node** leftTree, Node** rightTree) {
+	Node* found = split_node(root, key, leftTree, rightTree);
+	if (found != NULL)
+		*rightTree = join(NULL, found, *rightTree);
+}
 
-	if (!arr1 || !arr2 || !merged) {
-		free(arr1);
-		free(arr2);
-		free(merged);
-		return NULL; // Allocation failure
+typedef enum { SET_UNION, SET_INTERSECTION, SET_DIFFERENCE } SetOperation;
+
+/*
+* Worker threads that bulk set operations may still start (see avl_set_parallelism).
+*/
+static int spare_workers = 0;
+
+/*
+* Takes one worker from the budget, if any is left.
+*/
+static bool take_worker(void) {
+	int spare = __atomic_load_n(&spare_workers, __ATOMIC_RELAXED);
+	while (spare > 0)
+		if (__atomic_compare_exchange_n(&spare_workers, &spare, spare - 1, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			return true;
+	return false;
+}
+
+static void release_worker(void) {
+	__atomic_fetch_add(&spare_workers, 1, __ATOMIC_RELAXED);
+}
+
+/*
+* Sets how many extra threads the bulk set operations may use (0 runs them sequentially).
+*/
+void avl_set_parallelism(int threads) {
+	__atomic_store_n(&spare_workers, threads > 0 ? threads : 0, __ATOMIC_RELAXED);
+}
+
+static Node* set_operation(SetOperation op, Node* tree1, Node* tree2);
+
+/*
+* One branch of a set operation, handed to another thread.
+*/
+typedef struct {
+	SetOperation op;
+	Node* tree1;
+	Node* tree2;
+	Node* result;
+} SetTask;
+
+static void* set_task_run(void* arg) {
+	SetTask* task = arg;
+	task->result = set_operation(task->op, task->tree1, task->tree2);
+	return NULL;
+}
+
+/*
+* Runs the two independent branches of a set operation: the left one on a new thread when it is
+* large enough and the budget has a worker, the right one on the current thread.
+*/
+static void set_operation_branches(SetOperation op, Node* left1, Node* left2, Node* right1, Node* right2,
+                                   Node** left, Node** right) {
+	SetTask task = { op, left1, left2, NULL };
+	pthread_t thread;
+	bool forked = size(left1) + size(left2) >= PARALLEL_GRAIN && size(right1) + size(right2) >= PARALLEL_GRAIN
+		&& take_worker();
+	if (forked && pthread_create(&thread, NULL, set_task_run, &task) != 0) {
+		release_worker();
+		forked = false;
 	}
 
-	avl_to_array(tree1, arr1);
-	avl_to_array(tree2, arr2);
-	merge_sorted_arrays(arr1, size1, arr2, size2, merged);
+	*right = set_operation(op, right1, right2);
+	if (forked) {
+		pthread_join(thread, NULL);
+		release_worker();
+		*left = task.result;
+	} else {
+		*left = set_operation(op, left1, left2);
+	}
+}
 
-	Node* merged_tree = avl_from_sorted_array(merged, 0, size1 + size2 - 1);
+/*
+* Join-based union, intersection and difference: splits tree2 by the root of tree1, recurses on
+* the two independent halves and joins the results. Both trees are consumed: each node ends up
+* in the result or is freed. Costs O(m log(n/m + 1)) for trees of sizes m <= n.
+*/
+static Node* set_operation(SetOperation op, Node* tree1, Node* tree2) {
+	if (tree1 == NULL || tree2 == NULL) {
+		if (op == SET_UNION) return tree1 ? tree1 : tree2;
+		if (op == SET_DIFFERENCE && tree1 != NULL) return tree1;
+		avl_destroy(&tree1);
+		avl_destroy(&tree2);
+		return NULL;
+	}
 
-	free(arr1);
-	free(arr2);
-	free(merged);
+	Node* pivot = tree1;
+	Node* left1 = pivot->left;
+	Node* right1 = pivot->right;
+	Node* left2;
+	Node* right2;
+	Node* duplicate = split_node(tree2, pivot->data, &left2, &right2);
+
+	Node* left;
+	Node* right;
+	set_operation_branches(op, left1, left2, right1, right2, &left, &right);
+
+	// The pivot stays in the union always, in the intersection only if tree2 also had it,
+	// and in the difference only if tree2 did not
+	bool keep = op == SET_UNION || (op == SET_INTERSECTION) == (duplicate != NULL);
+	free(duplicate);
+	if (keep)
+		return join(left, pivot, right);
+	free(pivot);
+	return join2(left, right);
+}
 
-	return merged_tree;
+/*
+* Returns the union of two AVL trees, consuming both.
+*/
+Node* avl_union(Node* tree1, Node* tree2) {
+	return set_operation(SET_UNION, tree1, tree2);
 }
 
 /*
-* Splits AVL tree into two trees: those less than key and those >= key.
-* Returns via pointers leftTree and rightTree.
+* Returns the intersection of two AVL trees, consuming both.
 */
-void avl_split(Node* root, ElementType key, Node** leftTree, Node** rightTree) {
-	if (!root) {
-		*leftTree = NULL;
-		*rightTree = NULL;
-		return;
+Node* avl_intersection(Node* tree1, Node* tree2) {
+	return set_operation(SET_INTERSECTION, tree1, tree2);
+}
+
+/*
+* Returns the elements of tree1 that are not in tree2, consuming both trees.
+*/
+Node* avl_difference(Node* tree1, Node* tree2) {
+	return set_operation(SET_DIFFERENCE, tree1, tree2);
+}
+
+/*
+* Initializes an empty pooled AVL tree.
+*/
+void avl_tree_init(AvlTree* tree) {
+	tree->root = NULL;
+	tree->pool = (NodePool){NULL, 0, NULL};
+}
+
+/*
+* Takes a node from the pool: a removed one if any, otherwise the next one of the newest slab.
+*/
+static Node* pool_create_node(NodePool* pool, ElementType data) {
+	Node* node = pool->free_list;
+	if (node != NULL) {
+		pool->free_list = node->left;
+	} else {
+		if (pool->slabs == NULL || pool->used == pool->slabs->capacity) {
+			int capacity = pool->slabs == NULL ? POOL_SLAB_NODES : pool->slabs->capacity * 2;
+			if (capacity > POOL_MAX_SLAB_NODES) capacity = POOL_MAX_SLAB_NODES;
+			NodeSlab* slab = (NodeSlab*) malloc(sizeof(NodeSlab) + capacity * sizeof(Node));
+			if (!slab) {
+				fprintf(stderr, "Memory allocation failed\n");
+				exit(EXIT_FAILURE);
+			}
+			slab->next = pool->slabs;
+			slab->capacity = capacity;
+			pool->slabs = slab;
+			pool->used = 0;
+		}
+		node = &pool->slabs->nodes[pool->used++];
 	}
+	node->data = data;
+	node->refs = 1;
+	node->left = NULL;
+	node->right = NULL;
+	node->height = 0;
+	node->size = 1;
+	return node;
+}
+
+/*
+* Returns a node to the pool's free list.
+*/
+static void pool_free_node(NodePool* pool, Node* node) {
+	node->left = pool->free_list;
+	pool->free_list = node;
+}
+
+/*
+* Walks the recorded path bottom-up after an insertion or removal below path[depth - 1].
+* Each node is rebalanced while its subtree height keeps changing; above the first node whose
+* height is unchanged only the subtree sizes change (by delta), so no more rotations happen.
+*/
+static void retrace(Node** path[], int depth, int delta) {
+	int i = depth - 1;
+	for (; i >= 0; i--) {
+		Node* node = *path[i];
+		int old_height = node->height;
+		*path[i] = rebalance(node);
+		if ((*path[i])->height == old_height) {
+			i--;
+			break;
+		}
+	}
+	for (; i >= 0; i--)
+		(*path[i])->size += delta;
+}
+
+/*
+* Inserts data without recursion, recording the links followed on the way down.
+*/
+bool avl_tree_insert(AvlTree* tree, ElementType data) {
+	Node** path[AVL_MAX_HEIGHT];
+	int depth = 0;
+	Node** link = &tree->root;
+
+	while (*link != NULL) {
+		Node* node = *link;
+		if (data == node->data)
+			return false; // duplicate data not allowed
+		path[depth++] = link;
+		link = data < node->data ? &node->left : &node->right;
+	}
+
+	*link = pool_create_node(&tree->pool, data);
+	retrace(path, depth, 1);
+	return true;
+}
 
-	if (root->data < key) {
-		// Current root goes to left tree
-		Node* left_subtree = NULL;
-		Node* right_subtree = NULL;
-		avl_split(root->right, key, &left_subtree, &right_subtree);
+/*
+* Removes data without recursion. A node with two children takes its successor's data,
+* and the successor (which has no left child) is unlinked instead.
+*/
+bool avl_tree_remove(AvlTree* tree, ElementType data) {
+	Node** path[AVL_MAX_HEIGHT];
+	int depth = 0;
+	Node** link = &tree->root;
+
+	while (*link != NULL && (*link)->data != data) {
+		path[depth++] = link;
+		link = data < (*link)->data ? &(*link)->left : &(*link)->right;
+	}
+	if (*link == NULL)
+		return false;
 
-		root->right = left_subtree;
-		// Rebalance root if needed here (optional depending on your AVL code)
-		*leftTree = root;
-		*rightTree = right_subtree;
+	Node* target = *link;
+	if (target->left != NULL && target->right != NULL) {
+		path[depth++] = link;
+		link = &target->right;
+		while ((*link)->left != NULL) {
+			path[depth++] = link;
+			link = &(*link)->left;
+		}
+		Node* successor = *link;
+		target->data = successor->data;
+		*link = successor->right;
+		pool_free_node(&tree->pool, successor);
 	} else {
-		// Current root goes to right tree
-		Node* left_subtree = NULL;
-		Node* right_subtree = NULL;
-		avl_split(root->left, key, &left_subtree, &right_subtree);
+		*link = target->left ? target->left : target->right;
+		pool_free_node(&tree->pool, target);
+	}
+
+	retrace(path, depth, -1);
+	return true;
+}
 
-		root->left = right_subtree;
-		// Rebalance root if needed here (optional depending on your AVL code)
-		*leftTree = left_subtree;
-		*rightTree = root;
+/*
+* Frees the slabs of the tree's pool, which hold every node of the tree.
+*/
+void avl_tree_destroy(AvlTree* tree) {
+	NodeSlab* slab = tree->pool.slabs;
+	while (slab != NULL) {
+		NodeSlab* next = slab->next;
+		free(slab);
+		slab = next;
+	}
+	avl_tree_init(tree);
+}
+
+/*
+* Takes one more reference to a node of a persistent tree (atomic: snapshots may be released
+* by other threads at the same time).
+*/
+static Node* retain(Node* node) {
+	if (node != NULL)
+		__atomic_fetch_add(&node->refs, 1, __ATOMIC_RELAXED);
+	return node;
+}
+
+/*
+* Drops one reference to a node of a persistent tree. The last reference frees the node and
+* drops the references it held to its children.
+*/
+static void release(Node* node) {
+	while (node != NULL) {
+		if (__atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) != 0) return;
+		Node* right = node->right;
+		release(node->left);
+		free(node);
+		node = right; // the right child is released in the loop, so only the left side recurses
 	}
-}
\ No newline at end of file
+}
+
+/*
+* Copies a node for path copying: the copy shares (and retains) both children.
+*/
+static Node* copy_node(Node* node) {
+	Node* copy = create_node(node->data);
+	copy->left = retain(node->left);
+	copy->right = retain(node->right);
+	copy->height = node->height;
+	copy->size = node->size;
+	return copy;
+}
+
+/*
+* Returns a node that only the caller references, copying it if other versions share it.
+* A node with a single reference hangs from a node copied by this update, so nobody else can
+* reach it and it may be changed in place.
+*/
+static Node* unshare(Node* node) {
+	if (__atomic_load_n(&node->refs, __ATOMIC_ACQUIRE) == 1) return node;
+	Node* copy = copy_node(node);
+	release(node);
+	return copy;
+}
+
+/*
+* Rebalances a freshly copied node. Rotations change the child (and, in the double cases, the
+* grandchild) that moves up, so those are unshared first; the other subtrees are only re-linked.
+*/
+static Node* rebalance_persistent(Node* root) {
+	update(root);
+	int balance = get_balance(root);
+
+	if (balance > 1) {
+		root->left = unshare(root->left);
+		if (get_balance(root->left) < 0) {
+			root->left->right = unshare(root->left->right);
+			root->left = rotate_left(root->left);
+		}
+		return rotate_right(root);
+	}
+
+	if (balance < -1) {
+		root->right = unshare(root->right);
+		if (get_balance(root->right) > 0) {
+			root->right->left = unshare(root->right->left);
+			root->right = rotate_right(root->right);
+		}
+		return rotate_left(root);
+	}
+
+	return root;
+}
+
+/*
+* Inserts an element that is not in the subtree, copying the path from root to the new leaf.
+* return: a new subtree, referenced once by the caller.
+*/
+static Node* insert_persistent(Node* root, ElementType data) {
+	if (root == NULL)
+		return create_node(data);
+
+	Node* copy = copy_node(root);
+	if (data < root->data) {
+		Node* left = insert_persistent(root->left, data);
+		release(copy->left);
+		copy->left = left;
+	} else {
+		Node* right = insert_persistent(root->right, data);
+		release(copy->right);
+		copy->right = right;
+	}
+	return rebalance_persistent(copy);
+}
+
+/*
+* Removes an element that is in the subtree, copying the path from root to it.
+* return: a new subtree, referenced once by the caller.
+*/
+static Node* remove_persistent(Node* root, ElementType data) {
+	if (data == root->data && (root->left == NULL || root->right == NULL))
+		return retain(root->left ? root->left : root->right);
+
+	Node* copy = copy_node(root);
+	if (data < root->data) {
+		Node* left = remove_persistent(root->left, data);
+		release(copy->left);
+		copy->left = left;
+	} else {
+		// With two children the copy takes the successor's value, which is then removed on the right
+		if (data == root->data)
+			copy->data = data = find_min(root->right)->data;
+		Node* right = remove_persistent(root->right, data);
+		release(copy->right);
+		copy->right = right;
+	}
+	return rebalance_persistent(copy);
+}
+
+/*
+* Inserts into a persistent version without changing it: only the root-to-leaf path is copied.
+*/
+Node* avl_persistent_insert(Node* root, ElementType data) {
+	if (avl_contains_iterative(root, data))
+		return retain(root);
+	return insert_persistent(root, data);
+}
+
+/*
+* Removes from a persistent version without changing it: only the root-to-leaf path
+* (and the nodes rotated while rebalancing it) is copied.
+*/
+Node* avl_persistent_remove(Node* root, ElementType data) {
+	if (!avl_contains_iterative(root, data))
+		return retain(root);
+	return remove_persistent(root, data);
+}
+
+/*
+* Takes a snapshot of a persistent version in O(1): one more reference to its root.
+*/
+Node* avl_snapshot(Node* root) {
+	return retain(root);
+}
+
+/*
+* Releases a persistent version and frees the nodes no other version shares.
+*/
+void avl_release(Node** root) {
+	if (root == NULL) return;
+	release(*root);
+	*root = NULL;
+}
+
+/*
+* Helper function: fills the Eytzinger subtree rooted at slot k with sorted[i..], in order.
+* Returns the index of the first sorted key not used.
+*/
+static int eytzinger_fill(AvlFrozen* frozen, const ElementType sorted[], int i, int k) {
+	if (k > frozen->size) return i;
+	i = eytzinger_fill(frozen, sorted, i, 2 * k);
+	frozen->keys[k] = sorted[i];
+	frozen->ranks[k] = i;
+	return eytzinger_fill(frozen, sorted, i + 1, 2 * k + 1);
+}
+
+/*
+* Copies the keys of the tree into a frozen Eytzinger index.
+*/
+AvlFrozen* avl_freeze(Node* root) {
+	int size = avl_size(root);
+	// aligned_alloc needs a size multiple of the alignment
+	size_t bytes = ((size + 1) * sizeof(ElementType) + 63) / 64 * 64;
+	AvlFrozen* frozen = (AvlFrozen*) malloc(sizeof(AvlFrozen));
+	ElementType* sorted = (ElementType*) malloc((size + 1) * sizeof(ElementType));
+	if (frozen != NULL) {
+		frozen->keys = (ElementType*) aligned_alloc(64, bytes);
+		frozen->ranks = (int*) malloc((size + 1) * sizeof(int));
+	}
+	if (!frozen || !sorted || !frozen->keys || !frozen->ranks) {
+		fprintf(stderr, "Memory allocation failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	frozen->size = size;
+	avl_to_array(root, sorted, size);
+	eytzinger_fill(frozen, sorted, 0, 1);
+	free(sorted);
+	return frozen;
+}
+
+/*
+* Helper function: returns the slot of the smallest key >= data, or 0 if there is none.
+* The descent has no data-dependent branch: each step moves to the left or right child with
+* an add of the comparison result, and prefetches the cache line holding the 16 descendants
+* four levels below, so the memory latency overlaps with the next comparisons.
+* Going right on every key < data, the last left turn was taken at the answer; it is recovered
+* by dropping the trailing right turns (1 bits) and that left turn from k.
+*/
+static unsigned int frozen_lower_bound_slot(const AvlFrozen* frozen, ElementType data) {
+	const ElementType* keys = frozen->keys;
+	unsigned int size = (unsigned int) frozen->size;
+	unsigned int k = 1;
+
+	while (k <= size) {
+		__builtin_prefetch(keys + 16 * k);
+		k = 2 * k + (keys[k] < data);
+	}
+	return k >> __builtin_ffs(~k);
+}
+
+/*
+* Checks if data is in the frozen index.
+*/
+bool avl_frozen_contains(const AvlFrozen* frozen, ElementType data) {
+	unsigned int k = frozen_lower_bound_slot(frozen, data);
+	return k != 0 && frozen->keys[k] == data;
+}
+
+/*
+* Returns the smallest key >= data, or NULL.
+*/
+const ElementType* avl_frozen_lower_bound(const AvlFrozen* frozen, ElementType data) {
+	unsigned int k = frozen_lower_bound_slot(frozen, data);
+	return k != 0 ? &frozen->keys[k] : NULL;
+}
+
+/*
+* Returns the number of keys smaller than data: the rank of the lower bound, or every key.
+*/
+int avl_frozen_rank(const AvlFrozen* frozen, ElementType data) {
+	unsigned int k = frozen_lower_bound_slot(frozen, data);
+	return k != 0 ? frozen->ranks[k] : frozen->size;
+}
+
+/*
+* Frees the frozen index.
+*/
+void avl_frozen_destroy(AvlFrozen** frozen) {
+	if (*frozen == NULL) return;
+	free((*frozen)->keys);
+	free((*frozen)->ranks);
+	free(*frozen);
+	*frozen = NULL;
+}
@@ -13,11 +13,70 @@ typedef int ElementType;
 
 typedef struct Node {
 	ElementType data;
+	int refs; // versions and parent nodes that reference this node (persistent trees only)
 	struct Node* left;
 	struct Node* right;
 	int height;
+	int size; // number of nodes in the subtree rooted here (order statistics in O(log n))
 } Node;
 
+/*
+* Contiguous block of nodes owned by a tree's node pool.
+*/
+typedef struct NodeSlab {
+	struct NodeSlab* next; // previous (smaller) slab of the pool
+	int capacity; // number of nodes in this slab
+	Node nodes[];
+} NodeSlab;
+
+/*
+* Per-tree node allocator: nodes are handed out from slabs that double in size, and removed
+* nodes go to a free list (linked through their left pointer) to be reused by later inserts.
+*/
+typedef struct {
+	NodeSlab* slabs; // newest slab first
+	int used; // nodes already handed out from the newest slab
+	Node* free_list;
+} NodePool;
+
+/*
+* AVL tree that owns its nodes through a pool. Its root can be passed to every function that
+* only reads a tree, but not to the ones that free nodes (avl_remove, avl_destroy, avl_union...).
+*/
+typedef struct {
+	Node* root;
+	NodePool pool;
+} AvlTree;
+
+/*
+* Longest root-to-leaf path of an AVL tree: the height is below 1.45 * log2(n + 2), so 64 levels
+* cover any number of nodes that fits in memory.
+*/
+#define AVL_MAX_HEIGHT 64
+
+/*
+* In-order iterator over an AVL tree. It keeps its own stack of pending nodes, so it allocates
+* nothing and several iterators (one per thread, for instance) can walk trees at the same time.
+* The tree must not change while it is being iterated.
+*/
+typedef struct {
+	Node* root;
+	Node* stack[AVL_MAX_HEIGHT]; // nodes still to visit; the top one is the next
+	int depth;
+	bool reverse; // descending order
+} AvlIter;
+
+/*
+* Read-only index of a AVL tree's keys in Eytzinger (BFS) order: keys[1] is the root and the
+* children of keys[k] are keys[2k] and keys[2k+1]. The array is 64-byte aligned, so the 16
+* descendants four levels below any slot share one cache line.
+*/
+typedef struct {
+	ElementType* keys; // keys[1..size]; keys[0] is unused
+	int* ranks; // ranks[k]: number of keys smaller than keys[k]
+	int size;
+} AvlFrozen;
+
 /*
 * Creates an empty AVL tree (NULL root).
 * return: NULL pointer representing an empty tree.
@@ -74,7 +133,7 @@ void avl_postorder(Node* root);
 int avl_height(Node* root);
 
 /*
-* Returns the total number of nodes in the tree.
+* Returns the total number of nodes in the tree in O(1).
 * root: pointer to the root node.
 * return: number of nodes in the tree.
 */
@@ -111,28 +170,64 @@ Node* avl_successor(Node* root, ElementType data);
 Node* avl_predecessor(Node* root, ElementType data);
 
 /*
-* Returns the k-th smallest element in the AVL tree (1-based index).
+* Returns the k-th smallest element in the AVL tree (1-based index) in O(log n).
 * If k is invalid (<=0 or > size), returns NULL.
 */
 Node* avl_select(Node* root, int k);
 
 /*
-* Returns the rank of an element in the AVL tree.
+* Returns the rank of an element in the AVL tree in O(log n).
 * The rank is the number of elements less than the given element.
 */
 int avl_rank(Node* root, ElementType data);
 
+/*
+* Counts the elements in the closed interval [lo, hi] in O(log n).
+* root: pointer to the root node of the tree.
+* lo: lower bound of the interval.
+* hi: upper bound of the interval.
+* return: number of elements x with lo <= x <= hi (0 if lo > hi).
+*/
+int avl_range_count(Node* root, ElementType lo, ElementType hi);
+
 /*
 * Checks if the AVL tree is balanced.
 * Return: true if balanced, false otherwise.
 */
 bool avl_is_balanced(Node* root);
 
+/*
+* Starts an in-order iteration over the AVL tree.
+* it: pointer to the iterator.
+* root: pointer to the root node of the tree.
+* reverse: true to visit the elements in descending order.
+*/
+void avl_iter_init(AvlIter* it, Node* root, bool reverse);
+
+/*
+* Moves the iterator so that the next element is the first one >= data
+* (the last one <= data in reverse iteration).
+* it: pointer to an initialized iterator.
+* data: element to seek.
+*/
+void avl_iter_seek(AvlIter* it, ElementType data);
+
+/*
+* Gets the next element of the iteration.
+* it: pointer to the iterator.
+* data: receives the element.
+* return: true if there was a next element, false at the end of the iteration.
+*/
+bool avl_iter_next(AvlIter* it, ElementType* data);
+
 /*
 * Converts the AVL tree into a sorted array.
-* array: pre-allocated array of at least avl_size(root) elements.
+* root: pointer to the root node of the tree.
+* out: pre-allocated array.
+* cap: capacity of out; only the cap smallest elements are written if the tree has more.
+* return: number of elements written.
 */
-void avl_to_array(Node* root, ElementType array[]);
+int avl_to_array(Node* root, ElementType out[], int cap);
 
 /*
 * Builds a balanced AVL tree from a sorted array.
@@ -240,13 +335,152 @@ void avl_rotate_left(Node** root);
 void avl_rotate_right(Node** root);
 
 /*
-* Merges two AVL trees and returns the root of the merged AVL tree.
+* Merges two AVL trees and returns the root of the merged AVL tree (same as avl_union).
 */
 Node* avl_merge(Node* tree1, Node* tree2);
 
 /*
 * Splits AVL tree into two trees: those less than key and those >= key.
+* Both trees are balanced; the nodes of root are reused, so root must not be used afterwards.
+* Runs in O(log n).
 */
 void avl_split(Node* root, ElementType key, Node** leftTree, Node** rightTree);
 
+/*
+* Joins two AVL trees with a new element between them in O(|height(left) - height(right)|).
+* left: tree whose elements are all less than key.
+* key: element to insert between the trees.
+* right: tree whose elements are all greater than key.
+* return: pointer to the root node of the joined tree.
+*/
+Node* avl_join(Node* left, ElementType key, Node* right);
+
+/*
+* Bulk set operations built on split and join. Both trees are consumed (their nodes are reused
+* in the result or freed), so neither may be used afterwards. For trees of sizes m <= n they
+* cost O(m log(n/m + 1)), so merging a small tree into a large one is far cheaper than
+* inserting its elements one by one.
+* tree1, tree2: pointers to the root nodes of the trees.
+* return: pointer to the root node of the resulting tree.
+*/
+Node* avl_union(Node* tree1, Node* tree2);
+Node* avl_intersection(Node* tree1, Node* tree2);
+Node* avl_difference(Node* tree1, Node* tree2); // elements of tree1 not in tree2
+
+/*
+* Sets how many extra threads the bulk set operations may start (default 0: sequential).
+* The two halves of a large operation are independent, so the left one runs on a new thread
+* while the current thread handles the right one, as long as the budget has threads left.
+* threads: maximum number of extra threads running at the same time.
+*/
+void avl_set_parallelism(int threads);
+
+/*
+* Initializes an empty pooled AVL tree.
+* tree: pointer to the tree.
+*/
+void avl_tree_init(AvlTree* tree);
+
+/*
+* Inserts an element into a pooled AVL tree without recursion: the descent records the path in
+* a stack, and the retrace stops updating heights as soon as a subtree keeps its height.
+* tree: pointer to the tree.
+* data: element to insert.
+* return: true if inserted, false if the element was already in the tree.
+*/
+bool avl_tree_insert(AvlTree* tree, ElementType data);
+
+/*
+* Removes an element from a pooled AVL tree without recursion; the node goes back to the pool.
+* tree: pointer to the tree.
+* data: element to remove.
+* return: true if removed, false if the element was not in the tree.
+*/
+bool avl_tree_remove(AvlTree* tree, ElementType data);
+
+/*
+* Frees every node of a pooled AVL tree at once (one free per slab) and leaves it empty.
+* tree: pointer to the tree.
+*/
+void avl_tree_destroy(AvlTree* tree);
+
+/*
+* Persistent mode: updates never change the nodes of an existing version. They copy the path
+* from the root to the changed node (O(log n) new nodes), share every other subtree with the
+* previous version and return the root of a new version. Every version is an immutable snapshot
+* that can be read (with the functions that do not change the tree, from any thread) while
+* newer versions are created. Nodes are reference counted: each returned version must be
+* released with avl_release, which frees the nodes no other version still uses. A tree built
+* with avl_insert can be used as the first version, but a version must never be passed to the
+* functions that change trees in place (avl_insert, avl_remove, avl_split, avl_union...).
+*/
+
+/*
+* Inserts an element into a persistent version.
+* root: root of the version (not changed).
+* data: element to insert.
+* return: root of the new version, to be released with avl_release.
+*/
+Node* avl_persistent_insert(Node* root, ElementType data);
+
+/*
+* Removes an element from a persistent version.
+* root: root of the version (not changed).
+* data: element to remove.
+* return: root of the new version, to be released with avl_release.
+*/
+Node* avl_persistent_remove(Node* root, ElementType data);
+
+/*
+* Takes a snapshot of a persistent version in O(1).
+* root: root of the version.
+* return: the same root, with one more reference, to be released with avl_release.
+*/
+Node* avl_snapshot(Node* root);
+
+/*
+* Releases a version or snapshot and frees the nodes that no other version references.
+* root: pointer to the root node pointer (set to NULL).
+*/
+void avl_release(Node** root);
+
+/*
+* Copies the keys of a AVL tree into a frozen Eytzinger index. The tree is not changed,
+* and later changes to it are not seen by the index.
+* root: pointer to the root node of the tree.
+* return: pointer to the new frozen index.
+*/
+AvlFrozen* avl_freeze(Node* root);
+
+/*
+* Checks if an element exists in a frozen index (branchless search).
+* frozen: pointer to the frozen index.
+* data: element to search for.
+* return: true if element exists, false otherwise.
+*/
+bool avl_frozen_contains(const AvlFrozen* frozen, ElementType data);
+
+/*
+* Returns the smallest key of a frozen index that is greater than or equal to data.
+* frozen: pointer to the frozen index.
+* data: element to search for.
+* return: pointer to the key inside the index, or NULL if every key is smaller than data.
+*/
+const ElementType* avl_frozen_lower_bound(const AvlFrozen* frozen, ElementType data);
+
+/*
+* Returns the rank of an element in a frozen index.
+* The rank is the number of keys smaller than the given data.
+* frozen: pointer to the frozen index.
+* data: element to find the rank for.
+* return: rank of the element (0-based).
+*/
+int avl_frozen_rank(const AvlFrozen* frozen, ElementType data);
+
+/*
+* Frees a frozen index and sets its pointer to NULL.
+* frozen: pointer to the frozen index pointer.
+*/
+void avl_frozen_destroy(AvlFrozen** frozen);
+
 #endif
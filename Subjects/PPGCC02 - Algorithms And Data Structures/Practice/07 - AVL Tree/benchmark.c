@@ -0,0 +1,155 @@
+/*
+ * Description: Compares the recursive AVL tree (one malloc per node) with the pooled tree
+ * (slab allocator plus iterative insert/remove) on random inserts, searches and removals,
+ * and the searches of the tree with the ones of its frozen Eytzinger index.
+ * Author: Breno Farias da Silva.
+ * Date: 18/10/2026.
+ */
+
+// Compile: gcc -O2 -pthread benchmark.c avl.c -o benchmark
+// Run: ./benchmark [number of keys (default 10000000)] [seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "avl.h"
+
+#define DEFAULT_KEYS 10000000
+
+static uint64_t state; // splitmix64 state, so runs are reproducible
+
+/*
+ * Returns the next pseudo-random 64-bit number.
+ */
+static uint64_t next_random(void) {
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/*
+ * Returns the current monotonic time in seconds.
+ */
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Prints one line of the results table.
+ * phase: name of the measured phase.
+ * recursive: seconds taken by the recursive tree.
+ * pooled: seconds taken by the pooled tree.
+ * n: number of operations in the phase.
+ */
+static void report(const char* phase, double recursive, double pooled, int n) {
+	printf("%-9s %10.3f %10.3f %12.2f %12.2f %8.2fx\n", phase, recursive, pooled,
+		n / recursive * 1e-6, n / pooled * 1e-6, recursive / pooled);
+}
+
+/*
+ * Main function of the program.
+ * argc: number of arguments passed on program call.
+ * argv: array with the arguments passed on program call.
+ * return: program execution status (0: no errors, otherwise: error code).
+ */
+int main(int argc, char *argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : DEFAULT_KEYS;
+	state = argc > 2 ? strtoull(argv[2], NULL, 10) : 42;
+	if (n <= 0) {
+		fprintf(stderr, "Usage: %s [number of keys] [seed]\n", argv[0]);
+		return 1;
+	}
+
+	ElementType* keys = (ElementType*) malloc(n * sizeof(ElementType));
+	if (!keys) {
+		fprintf(stderr, "Memory allocation failed\n");
+		return 1;
+	}
+	for (int i = 0; i < n; i++)
+		keys[i] = (ElementType) (next_random() >> 33); // non-negative, duplicates are possible
+
+	Node* root = avl_create();
+	AvlTree tree;
+	avl_tree_init(&tree);
+	double start, recursive, pooled;
+	long found = 0;
+
+	printf("%d random keys\n", n);
+	printf("%-9s %10s %10s %12s %12s %9s\n", "phase", "recur. (s)", "pooled (s)", "recur. Mop/s", "pooled Mop/s", "speedup");
+
+	start = now();
+	for (int i = 0; i < n; i++)
+		root = avl_insert(root, keys[i]);
+	recursive = now() - start;
+	start = now();
+	for (int i = 0; i < n; i++)
+		avl_tree_insert(&tree, keys[i]);
+	pooled = now() - start;
+	report("insert", recursive, pooled, n);
+
+	if (avl_size(root) != avl_size(tree.root) || !avl_is_valid(tree.root)) {
+		fprintf(stderr, "The trees differ after the inserts\n");
+		return 1;
+	}
+
+	// Searches run on both roots with the same function, so the difference is node layout only
+	start = now();
+	for (int i = 0; i < n; i++)
+		found += avl_contains_iterative(root, keys[i]);
+	recursive = now() - start;
+	start = now();
+	for (int i = 0; i < n; i++)
+		found += avl_contains_iterative(tree.root, keys[i]);
+	pooled = now() - start;
+	report("search", recursive, pooled, n);
+
+	// The frozen index of the same keys against pointer chasing with avl_contains
+	AvlFrozen* frozen = avl_freeze(root);
+	double tree_search, frozen_search;
+	start = now();
+	for (int i = 0; i < n; i++)
+		found += avl_contains(root, keys[i]);
+	tree_search = now() - start;
+	start = now();
+	for (int i = 0; i < n; i++)
+		found += avl_frozen_contains(frozen, keys[i]);
+	frozen_search = now() - start;
+	avl_frozen_destroy(&frozen);
+	printf("frozen search: avl_contains %.3f s, avl_frozen_contains %.3f s (%.2fx)\n",
+		tree_search, frozen_search, tree_search / frozen_search);
+
+	start = now();
+	for (int i = 0; i < n; i++)
+		root = avl_remove(root, keys[i]);
+	recursive = now() - start;
+	start = now();
+	for (int i = 0; i < n; i++)
+		avl_tree_remove(&tree, keys[i]);
+	pooled = now() - start;
+	report("remove", recursive, pooled, n);
+
+	if (root != NULL || tree.root != NULL || found != 4L * n) {
+		fprintf(stderr, "The trees are not empty after the removals\n");
+		return 1;
+	}
+
+	// Reinsert and time the teardown: one free per node against one free per slab
+	for (int i = 0; i < n; i++) {
+		root = avl_insert(root, keys[i]);
+		avl_tree_insert(&tree, keys[i]);
+	}
+	start = now();
+	avl_destroy(&root);
+	recursive = now() - start;
+	start = now();
+	avl_tree_destroy(&tree);
+	pooled = now() - start;
+	report("destroy", recursive, pooled, n);
+
+	free(keys);
+	return 0;
+}
@@ -77,16 +77,37 @@ int main(int argc, char *argv[]) {
 	int rank = avl_rank(root, rank_key);
 	printf("Rank of %d: %d\n", rank_key, rank);
 
+	// Test avl_range_count
+	printf("Elements in [10, 25]: %d\n", avl_range_count(root, 10, 25));
+
+	// Median through the subtree sizes: select the middle rank
+	Node* median = avl_select(root, (avl_size(root) + 1) / 2);
+	printf("Median element: %d\n", median ? median->data : -1);
+
 	// Test avl_to_array
 	int size = avl_size(root);
 	ElementType array[size];
-	avl_to_array(root, array);
+	avl_to_array(root, array, size);
 	printf("\nTree as sorted array: ");
 	for (int i = 0; i < size; i++) {
 		printf("%d ", array[i]);
 	}
 	printf("\n");
 
+	// Iterators: descending order, and ascending from the first element >= 12
+	AvlIter it;
+	ElementType value;
+	avl_iter_init(&it, root, true);
+	printf("Descending iteration: ");
+	while (avl_iter_next(&it, &value))
+		printf("%d ", value);
+	avl_iter_init(&it, root, false);
+	avl_iter_seek(&it, 12);
+	printf("\nAscending from 12: ");
+	while (avl_iter_next(&it, &value))
+		printf("%d ", value);
+	printf("\n");
+
 	// Test avl_from_sorted_array
 	Node* new_tree = avl_from_sorted_array(array, 0, size - 1);
 	printf("\nTree built from sorted array (inorder traversal):\n");
@@ -192,6 +213,7 @@ int main(int argc, char *argv[]) {
 	Node* leftTree = NULL;
 	Node* rightTree = NULL;
 	avl_split(root, 20, &leftTree, &rightTree);
+	root = NULL; // avl_split reuses the nodes of root
 
 	printf("Left tree (elements < 20):\n");
 	avl_inorder(leftTree);
@@ -199,20 +221,82 @@ int main(int argc, char *argv[]) {
 	avl_inorder(rightTree);
 	printf("\n");
 
-	// Merge back
+	// Merge back (consumes both split trees)
 	Node* mergedTree = avl_merge(leftTree, rightTree);
 	printf("\nMerged tree after split:\n");
 	avl_inorder(mergedTree);
 	printf("\n");
+	printf("Is merged tree valid AVL? %s\n", avl_is_valid(mergedTree) ? "Yes" : "No");
+
+	printf("\n--- Testing bulk set operations ---\n");
+	Node* evens = NULL;
+	Node* threes = NULL;
+	for (int i = 0; i <= 30; i += 2) evens = avl_insert(evens, i);
+	for (int i = 0; i <= 30; i += 3) threes = avl_insert(threes, i);
+
+	// Each operation consumes its inputs, so clones are passed to the first two
+	Node* both = avl_intersection(avl_clone(evens), avl_clone(threes));
+	printf("Multiples of 2 and 3: ");
+	avl_inorder(both);
+	Node* only_evens = avl_difference(avl_clone(evens), avl_clone(threes));
+	printf("\nMultiples of 2 but not 3: ");
+	avl_inorder(only_evens);
+	Node* either = avl_union(evens, threes);
+	printf("\nMultiples of 2 or 3: ");
+	avl_inorder(either);
+	printf("\n");
+
+	// Join: every element of the left tree < 100 < every element of the right tree
+	ElementType high[] = {200, 300, 400};
+	Node* joined = avl_join(either, 100, avl_from_sorted_array(high, 0, 2));
+	printf("Joined with 100 and {200, 300, 400}: ");
+	avl_inorder(joined);
+	printf("\nIs joined tree valid AVL? %s\n", avl_is_valid(joined) ? "Yes" : "No");
+
+	printf("\n--- Testing persistent versions ---\n");
+	Node* version1 = NULL;
+	for (int i = 1; i <= 7; i++) {
+		Node* next = avl_persistent_insert(version1, i * 10);
+		avl_release(&version1);
+		version1 = next;
+	}
+
+	// Snapshot in O(1), then keep updating: the snapshot still sees the old contents
+	Node* snapshot = avl_snapshot(version1);
+	Node* version2 = avl_persistent_insert(version1, 35);
+	Node* version3 = avl_persistent_remove(version2, 10);
+	avl_release(&version1);
+
+	printf("Snapshot: ");
+	avl_inorder(snapshot);
+	printf("\nAfter inserting 35: ");
+	avl_inorder(version2);
+	printf("\nAfter removing 10: ");
+	avl_inorder(version3);
+	printf("\nAre all versions valid AVL? %s\n",
+		avl_is_valid(snapshot) && avl_is_valid(version2) && avl_is_valid(version3) ? "Yes" : "No");
+
+	avl_release(&snapshot);
+	avl_release(&version2);
+	avl_release(&version3);
+
+	printf("\n--- Testing frozen index ---\n");
+	AvlFrozen* frozen = avl_freeze(joined);
+	const ElementType* bound = avl_frozen_lower_bound(frozen, 150);
+	printf("Frozen %d keys. Contains 300? %s. Contains 250? %s\n", frozen->size,
+		avl_frozen_contains(frozen, 300) ? "Yes" : "No", avl_frozen_contains(frozen, 250) ? "Yes" : "No");
+	printf("Lower bound of 150: %d, rank of 150: %d\n", bound ? *bound : -1, avl_frozen_rank(frozen, 150));
+	avl_frozen_destroy(&frozen);
 
-	// Clean up split trees (if your avl_destroy works fine)
-	avl_destroy(&leftTree);
-	avl_destroy(&rightTree);
 	avl_destroy(&mergedTree);
+	avl_destroy(&both);
+	avl_destroy(&only_evens);
+	avl_destroy(&joined);
 
 	// Cleanup
 	avl_destroy(&root);
 	avl_destroy(&clone);
+	avl_destroy(&new_tree);
 
 	if (root == NULL && clone == NULL) {
 		printf("Trees successfully destroyed after tests.\n");
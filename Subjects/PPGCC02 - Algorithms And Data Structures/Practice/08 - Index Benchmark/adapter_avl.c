@@ -0,0 +1,51 @@
+/*
+* Description: Benchmark adapter for the AVL tree of "Practice/07 - AVL Tree".
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+#include <stdlib.h> // malloc, free
+#include "benchmark.h"
+#include "../07 - AVL Tree/avl.c"
+
+/*
+* The handle owns the root, since avl_insert returns the new root.
+*/
+typedef struct {
+	Node* root;
+} AvlIndex;
+
+static void* avl_index_create(int capacity) {
+	AvlIndex* index = malloc(sizeof(AvlIndex));
+	index->root = avl_create();
+	return index;
+}
+
+static void avl_index_insert(void* index, int key) {
+	AvlIndex* avl = index;
+	avl->root = avl_insert(avl->root, key);
+}
+
+static bool avl_index_contains(void* index, int key) {
+	return avl_contains_iterative(((AvlIndex*)index)->root, key);
+}
+
+/*
+* Walks the interval with successor queries, one root-to-leaf descent per key.
+*/
+static int avl_index_range(void* index, int low, int high) {
+	Node* root = ((AvlIndex*)index)->root;
+	int count = avl_contains_iterative(root, low) ? 1 : 0;
+	for (Node* next = avl_successor(root, low); next != NULL && next->data <= high; next = avl_successor(root, next->data))
+		count++;
+	return count;
+}
+
+static void avl_index_destroy(void* index) {
+	avl_destroy(&((AvlIndex*)index)->root);
+	free(index);
+}
+
+const IndexAdapter index_adapter = {
+	"avl", avl_index_create, avl_index_insert, avl_index_contains, avl_index_range, avl_index_destroy
+};
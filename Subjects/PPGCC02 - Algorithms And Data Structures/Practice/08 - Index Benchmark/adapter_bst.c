@@ -0,0 +1,51 @@
+/*
+* Description: Benchmark adapter for the unbalanced BST of "Practice/06 - Binary Tree".
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+#include <stdlib.h> // malloc, free
+#include "benchmark.h"
+#include "../06 - Binary Tree/binary_tree.c"
+
+/*
+* The handle owns the root, since bst_insert returns the new root.
+*/
+typedef struct {
+	Node* root;
+} BstIndex;
+
+static void* bst_index_create(int capacity) {
+	BstIndex* index = malloc(sizeof(BstIndex));
+	index->root = bst_create();
+	return index;
+}
+
+static void bst_index_insert(void* index, int key) {
+	BstIndex* bst = index;
+	bst->root = bst_insert(bst->root, key);
+}
+
+static bool bst_index_contains(void* index, int key) {
+	return bst_contains_iterative(((BstIndex*)index)->root, key);
+}
+
+/*
+* Walks the interval with successor queries, one root-to-leaf descent per key.
+*/
+static int bst_index_range(void* index, int low, int high) {
+	Node* root = ((BstIndex*)index)->root;
+	int count = bst_contains_iterative(root, low) ? 1 : 0;
+	for (Node* next = bst_successor(root, low); next != NULL && next->data <= high; next = bst_successor(root, next->data))
+		count++;
+	return count;
+}
+
+static void bst_index_destroy(void* index) {
+	bst_destroy(&((BstIndex*)index)->root);
+	free(index);
+}
+
+const IndexAdapter index_adapter = {
+	"bst", bst_index_create, bst_index_insert, bst_index_contains, bst_index_range, bst_index_destroy
+};
@@ -0,0 +1,64 @@
+/*
+* Description: Benchmark adapter for the persistent B-Tree of
+* "Activities/Activity 11 - B Trees/02 - B Tree Structure - Disk Structure".
+* Every run starts from an empty index file, which is removed on destroy.
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+#include <stdio.h> // remove
+#include <stdlib.h> // free
+#include "benchmark.h"
+#include "../../Activities/Activity 11 - B Trees/02 - B Tree Structure - Disk Structure/b_tree.c"
+
+#define BENCHMARK_FILENAME "bench_btree_disk.dat" // Scratch index file of the run
+
+static void* btree_disk_create(int capacity) {
+	remove(BENCHMARK_FILENAME);
+	return btree_open(BENCHMARK_FILENAME);
+}
+
+static void btree_disk_insert(void* index, int key) {
+	btree_insert((BTree*)index, key);
+}
+
+static bool btree_disk_contains(void* index, int key) {
+	return btree_search((BTree*)index, key) == 1;
+}
+
+/*
+* Counts the keys of the subtree inside [low, high], reading only the children
+* whose separator keys overlap the interval.
+*/
+static int btree_disk_count(BTree* tree, BTreeNode* node, int low, int high) {
+	int count = 0;
+	int i = 0;
+	while (i < node->n && node->keys[i] < low) i++;
+	for (; i <= node->n; i++) {
+		if (!node->leaf) {
+			BTreeNode* child = btree_read_node(tree, node->children[i]);
+			count += btree_disk_count(tree, child, low, high);
+			free(child);
+		}
+		if (i == node->n || node->keys[i] > high) break;
+		count++;
+	}
+	return count;
+}
+
+static int btree_disk_range(void* index, int low, int high) {
+	BTree* tree = index;
+	BTreeNode* root = btree_read_node(tree, tree->root_pos);
+	int count = btree_disk_count(tree, root, low, high);
+	free(root);
+	return count;
+}
+
+static void btree_disk_destroy(void* index) {
+	btree_close((BTree*)index);
+	remove(BENCHMARK_FILENAME);
+}
+
+const IndexAdapter index_adapter = {
+	"btree_disk", btree_disk_create, btree_disk_insert, btree_disk_contains, btree_disk_range, btree_disk_destroy
+};
@@ -0,0 +1,61 @@
+/*
+* Description: Benchmark adapter for the in-memory B-Tree of
+* "Activities/Activity 11 - B Trees/01 - B Tree Structure - Memory Structure".
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+#include <stdlib.h> // free
+#include "benchmark.h"
+#include "../../Activities/Activity 11 - B Trees/01 - B Tree Structure - Memory Structure/b_tree.c"
+
+static void* btree_memory_create(int capacity) {
+	return btree_create();
+}
+
+static void btree_memory_insert(void* index, int key) {
+	btree_insert((BTree*)index, key);
+}
+
+static bool btree_memory_contains(void* index, int key) {
+	return btree_search(((BTree*)index)->root, key) != NULL;
+}
+
+/*
+* Counts the keys of the subtree inside [low, high], skipping the children whose
+* separator keys place them outside the interval.
+*/
+static int btree_memory_count(BTreeNode* node, int low, int high) {
+	int count = 0;
+	int i = 0;
+	while (i < node->n && node->keys[i] < low) i++;
+	for (; i <= node->n; i++) {
+		if (!node->leaf) count += btree_memory_count(node->children[i], low, high);
+		if (i == node->n || node->keys[i] > high) break;
+		count++;
+	}
+	return count;
+}
+
+static int btree_memory_range(void* index, int low, int high) {
+	return btree_memory_count(((BTree*)index)->root, low, high);
+}
+
+/*
+* Frees a subtree; the B-Tree module has no destroy function of its own.
+*/
+static void btree_memory_free(BTreeNode* node) {
+	if (!node->leaf)
+		for (int i = 0; i <= node->n; i++)
+			btree_memory_free(node->children[i]);
+	free(node);
+}
+
+static void btree_memory_destroy(void* index) {
+	btree_memory_free(((BTree*)index)->root);
+	free(index);
+}
+
+const IndexAdapter index_adapter = {
+	"btree_memory", btree_memory_create, btree_memory_insert, btree_memory_contains, btree_memory_range, btree_memory_destroy
+};
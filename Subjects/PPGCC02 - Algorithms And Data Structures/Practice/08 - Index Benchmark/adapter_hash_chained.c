@@ -0,0 +1,48 @@
+/*
+* Description: Benchmark adapter for the chained hash table of
+* "Activities/Activity 08 - Hash Tables/01 - Class Structure/03 - Hash Table - Linked List".
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+#include <stdlib.h> // malloc
+#include "benchmark.h"
+#include "../../Activities/Activity 08 - Hash Tables/01 - Class Structure/03 - Hash Table - Linked List/hash.c"
+
+/*
+* One bucket per expected key (load factor at most 1); hash_destruir frees the elements.
+*/
+static void* hash_chained_create(int capacity) {
+	return hash_criar(capacity);
+}
+
+static void hash_chained_insert(void* index, int key) {
+	TipoElemento* element = malloc(sizeof(TipoElemento));
+	element->chave = key;
+	element->dado = key;
+	hash_inserir((Hash*)index, element);
+}
+
+static bool hash_chained_contains(void* index, int key) {
+	TipoElemento* element;
+	return hash_buscar_linear((Hash*)index, key, &element);
+}
+
+/*
+* Hash tables have no key order: the interval is answered with one lookup per key.
+*/
+static int hash_chained_range(void* index, int low, int high) {
+	int count = 0;
+	for (int key = low; key <= high; key++)
+		count += hash_chained_contains(index, key);
+	return count;
+}
+
+static void hash_chained_destroy(void* index) {
+	Hash* h = index;
+	hash_destruir(&h);
+}
+
+const IndexAdapter index_adapter = {
+	"hash_chained", hash_chained_create, hash_chained_insert, hash_chained_contains, hash_chained_range, hash_chained_destroy
+};
@@ -0,0 +1,47 @@
+/*
+* Description: Benchmark adapter for the open-addressing hash table (linear probing) of
+* "Activities/Activity 08 - Hash Tables/01 - Class Structure/01 - Hash Table" in its
+* inline mode, where the {chave, dado} records live in the table array itself.
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+#include "benchmark.h"
+#include "../../Activities/Activity 08 - Hash Tables/01 - Class Structure/01 - Hash Table/hash.c"
+
+/*
+* The table copies each record, so no element storage is kept beside it. It does not
+* grow by itself, so it is created at twice the capacity (load factor at most 0.5).
+*/
+static void* hash_inline_create(int capacity) {
+	return hash_criar_modo(2 * capacity, HASH_INLINE);
+}
+
+static void hash_inline_insert(void* index, int key) {
+	TipoElemento element = { key, key };
+	hash_inserir_linear(index, &element);
+}
+
+static bool hash_inline_contains(void* index, int key) {
+	TipoElemento* element;
+	return hash_buscar_linear(index, key, &element);
+}
+
+/*
+* Hash tables have no key order: the interval is answered with one lookup per key.
+*/
+static int hash_inline_range(void* index, int low, int high) {
+	int count = 0;
+	for (int key = low; key <= high; key++)
+		count += hash_inline_contains(index, key);
+	return count;
+}
+
+static void hash_inline_destroy(void* index) {
+	Hash* h = index;
+	hash_destruir(&h);
+}
+
+const IndexAdapter index_adapter = {
+	"hash_inline", hash_inline_create, hash_inline_insert, hash_inline_contains, hash_inline_range, hash_inline_destroy
+};
@@ -0,0 +1,66 @@
+/*
+* Description: Benchmark adapter for the open-addressing hash table (linear probing) of
+* "Activities/Activity 08 - Hash Tables/01 - Class Structure/01 - Hash Table".
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+#include <stdlib.h> // malloc, free
+#include "benchmark.h"
+#include "../../Activities/Activity 08 - Hash Tables/01 - Class Structure/01 - Hash Table/hash.c"
+
+/*
+* The table stores pointers to caller-owned elements, so the handle keeps them in one
+* array sized for the whole run and releases it on destroy.
+*/
+typedef struct {
+	Hash* table;
+	TipoElemento* elements;
+	int used;
+} HashLinearIndex;
+
+/*
+* The table does not grow by itself, so it is created at twice the capacity
+* (load factor at most 0.5).
+*/
+static void* hash_linear_create(int capacity) {
+	HashLinearIndex* index = malloc(sizeof(HashLinearIndex));
+	index->table = hash_criar(2 * capacity);
+	index->elements = malloc(capacity * sizeof(TipoElemento));
+	index->used = 0;
+	return index;
+}
+
+static void hash_linear_insert(void* index, int key) {
+	HashLinearIndex* h = index;
+	TipoElemento* element = &h->elements[h->used++];
+	element->chave = key;
+	element->dado = key;
+	hash_inserir_linear(h->table, element);
+}
+
+static bool hash_linear_contains(void* index, int key) {
+	TipoElemento* element;
+	return hash_buscar_linear(((HashLinearIndex*)index)->table, key, &element);
+}
+
+/*
+* Hash tables have no key order: the interval is answered with one lookup per key.
+*/
+static int hash_linear_range(void* index, int low, int high) {
+	int count = 0;
+	for (int key = low; key <= high; key++)
+		count += hash_linear_contains(index, key);
+	return count;
+}
+
+static void hash_linear_destroy(void* index) {
+	HashLinearIndex* h = index;
+	hash_destruir(&h->table);
+	free(h->elements);
+	free(h);
+}
+
+const IndexAdapter index_adapter = {
+	"hash_linear", hash_linear_create, hash_linear_insert, hash_linear_contains, hash_linear_range, hash_linear_destroy
+};
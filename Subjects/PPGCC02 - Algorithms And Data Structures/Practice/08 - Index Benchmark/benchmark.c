@@ -0,0 +1,279 @@
+/*
+* Description: Reproducible YCSB-style benchmark driver for the index structures of the
+* course (in-memory and disk B-Trees, AVL tree, BST and hash tables). The driver is
+* linked with one adapter per executable and prints one CSV row per workload with
+* throughput, p50/p99 latency and peak resident memory.
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+// Compile: make (builds one bench_<structure> executable per adapter)
+// Run: ./bench_avl [records] [operations] [seed] [--no-header]
+//      make run (runs every structure and writes results.csv)
+
+#include <stdio.h> // printf, fprintf, fflush
+#include <stdlib.h> // malloc, free, atoi, qsort
+#include <string.h> // strcmp
+#include <stdint.h> // uint64_t
+#include <math.h> // pow
+#include <time.h> // clock_gettime
+#include <unistd.h> // fork, _exit
+#include <sys/wait.h> // waitpid
+#include <sys/resource.h> // getrusage
+#include "benchmark.h"
+
+#define DEFAULT_RECORDS 100000 // Keys inserted in the load phase
+#define DEFAULT_OPERATIONS 100000 // Operations measured in the run phase
+#define DEFAULT_SEED 42 // Seed of the pseudo-random generator
+#define MAX_SCAN_LENGTH 100 // Longest key interval visited by a range operation
+#define ZIPFIAN_THETA 0.99 // Skew used by YCSB for its Zipfian distribution
+
+/*
+* Distribution used to pick the keys of reads and range operations.
+*/
+typedef enum { DIST_UNIFORM, DIST_ZIPFIAN, DIST_SEQUENTIAL } Distribution;
+
+/*
+* Operation mix of a workload, in percentages that add up to 100.
+*/
+typedef struct {
+	const char* name;
+	int read_percent;
+	int insert_percent;
+	int scan_percent;
+	Distribution distribution;
+} Workload;
+
+/*
+* Workloads modeled after the YCSB core workloads.
+* In "sequential" the keys are loaded in random order, reads walk the key space in
+* ascending order and inserts append past the largest key; the other workloads
+* insert new keys in random order.
+*/
+static const Workload workloads[] = {
+	{ "uniform", 50, 50, 0, DIST_UNIFORM },
+	{ "zipfian", 95, 5, 0, DIST_ZIPFIAN },
+	{ "sequential", 50, 50, 0, DIST_SEQUENTIAL },
+	{ "read_heavy", 95, 5, 0, DIST_UNIFORM },
+	{ "insert_heavy", 10, 90, 0, DIST_UNIFORM },
+	{ "range", 0, 5, 95, DIST_UNIFORM }
+};
+
+#define WORKLOAD_COUNT (int)(sizeof(workloads) / sizeof(workloads[0]))
+
+/*
+* Receives the lookup results so the compiler cannot discard the measured calls.
+*/
+static volatile long sink;
+
+/*
+* Pseudo-random generator state (splitmix64), so runs are reproducible from the seed.
+*/
+static uint64_t rng_state;
+
+/*
+* Returns the next 64-bit pseudo-random number.
+*/
+static uint64_t rng_next(void) {
+	uint64_t z = (rng_state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/*
+* Returns a pseudo-random integer in [0, bound).
+*/
+static int rng_below(int bound) {
+	return (int)(rng_next() % (uint64_t)bound);
+}
+
+/*
+* Returns a pseudo-random double in [0, 1).
+*/
+static double rng_double(void) {
+	return (rng_next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*
+* Precomputed constants of the Zipfian generator (Gray et al., as used by YCSB).
+*/
+typedef struct {
+	int items;
+	double zetan, alpha, eta, half_pow_theta;
+} Zipfian;
+
+/*
+* Prepares a Zipfian generator over ranks [0, items).
+*/
+static void zipfian_init(Zipfian* z, int items) {
+	double zeta2 = 1.0 + pow(0.5, ZIPFIAN_THETA);
+	z->items = items;
+	z->zetan = 0.0;
+	for (int i = 1; i <= items; i++)
+		z->zetan += 1.0 / pow((double)i, ZIPFIAN_THETA);
+	z->alpha = 1.0 / (1.0 - ZIPFIAN_THETA);
+	z->eta = (1.0 - pow(2.0 / items, 1.0 - ZIPFIAN_THETA)) / (1.0 - zeta2 / z->zetan);
+	z->half_pow_theta = pow(0.5, ZIPFIAN_THETA);
+}
+
+/*
+* Draws a rank from the Zipfian generator; rank 0 is the most popular.
+*/
+static int zipfian_next(Zipfian* z) {
+	double u = rng_double();
+	double uz = u * z->zetan;
+	if (uz < 1.0) return 0;
+	if (uz < 1.0 + z->half_pow_theta) return 1;
+	int rank = (int)(z->items * pow(z->eta * u - z->eta + 1.0, z->alpha));
+	return rank < z->items ? rank : z->items - 1;
+}
+
+/*
+* Returns a monotonic timestamp in nanoseconds.
+*/
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+* Comparison function used by qsort to order latencies.
+*/
+static int compare_u64(const void* a, const void* b) {
+	uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+/*
+* Shuffles array[start..end) in place (Fisher-Yates).
+*/
+static void shuffle(int array[], int start, int end) {
+	for (int i = end - 1; i > start; i--) {
+		int j = start + rng_below(i - start + 1);
+		int tmp = array[i];
+		array[i] = array[j];
+		array[j] = tmp;
+	}
+}
+
+/*
+* Loads the index and runs one workload, printing its CSV row.
+* Executed in a child process so that the reported peak RSS belongs to this
+* structure and workload only.
+*/
+static int run_workload(const Workload* w, int records, int operations, uint64_t seed) {
+	int total = records + operations;
+	int* keys = malloc(total * sizeof(int));
+	uint64_t* latencies = malloc(operations * sizeof(uint64_t));
+	if (!keys || !latencies) {
+		fprintf(stderr, "Memory allocation failed\n");
+		return 1;
+	}
+
+	// Key order: loaded keys first, then the keys available to inserts
+	rng_state = seed + (uint64_t)(w - workloads);
+	for (int i = 0; i < total; i++) keys[i] = i;
+	if (w->distribution == DIST_SEQUENTIAL)
+		shuffle(keys, 0, records);
+	else
+		shuffle(keys, 0, total);
+
+	Zipfian zipf = { 0 };
+	if (w->distribution == DIST_ZIPFIAN) zipfian_init(&zipf, records);
+
+	void* index = index_adapter.create(total);
+
+	uint64_t start = now_ns();
+	for (int i = 0; i < records; i++)
+		index_adapter.insert(index, keys[i]);
+	uint64_t load_ns = now_ns() - start;
+
+	int present = records; // keys[0..present) are in the index
+	int cursor = 0; // Next key visited by sequential reads
+	long found = 0;
+
+	uint64_t run_start = now_ns();
+	for (int op = 0; op < operations; op++) {
+		int dice = rng_below(100);
+		int key;
+		if (w->distribution == DIST_ZIPFIAN)
+			key = keys[zipfian_next(&zipf)];
+		else if (w->distribution == DIST_SEQUENTIAL)
+			key = cursor++ % present;
+		else
+			key = keys[rng_below(present)];
+
+		uint64_t t0 = now_ns();
+		if (dice < w->read_percent) {
+			found += index_adapter.contains(index, key);
+		} else if (dice < w->read_percent + w->insert_percent) {
+			index_adapter.insert(index, keys[present++]);
+		} else {
+			found += index_adapter.range(index, key, key + rng_below(MAX_SCAN_LENGTH));
+		}
+		latencies[op] = now_ns() - t0;
+	}
+	uint64_t run_ns = now_ns() - run_start;
+
+	qsort(latencies, operations, sizeof(uint64_t), compare_u64);
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+
+	printf("%s,%s,%d,%d,%llu,%.0f,%.0f,%llu,%llu,%ld\n",
+		index_adapter.name, w->name, records, operations, (unsigned long long)seed,
+		records / (load_ns / 1e9), operations / (run_ns / 1e9),
+		(unsigned long long)latencies[operations / 2],
+		(unsigned long long)latencies[(int)(operations * 0.99)],
+		usage.ru_maxrss);
+	fflush(stdout);
+
+	sink = found;
+	index_adapter.destroy(index);
+	free(keys);
+	free(latencies);
+	return 0;
+}
+
+/*
+* Main function of the program.
+* argc: number of arguments passed on program call.
+* argv: records, operations, seed and the optional --no-header flag.
+* return: program execution status (0: no errors, otherwise: error code).
+*/
+int main(int argc, char *argv[]) {
+	int records = argc > 1 ? atoi(argv[1]) : DEFAULT_RECORDS;
+	int operations = argc > 2 ? atoi(argv[2]) : DEFAULT_OPERATIONS;
+	uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : DEFAULT_SEED;
+	int header = !(argc > 4 && strcmp(argv[4], "--no-header") == 0);
+
+	if (records <= 0 || operations <= 0) {
+		fprintf(stderr, "Usage: %s [records] [operations] [seed] [--no-header]\n", argv[0]);
+		return 1;
+	}
+
+	if (header)
+		printf("structure,workload,records,operations,seed,load_ops_per_sec,run_ops_per_sec,p50_ns,p99_ns,peak_rss_kb\n");
+	fflush(stdout);
+
+	int status = 0;
+	for (int i = 0; i < WORKLOAD_COUNT; i++) {
+		pid_t pid = fork();
+		if (pid < 0) {
+			perror("fork");
+			return 1;
+		}
+		if (pid == 0)
+			_exit(run_workload(&workloads[i], records, operations, seed));
+
+		int child_status;
+		waitpid(pid, &child_status, 0);
+		if (!WIFEXITED(child_status) || WEXITSTATUS(child_status) != 0) {
+			fprintf(stderr, "%s: workload %s failed\n", index_adapter.name, workloads[i].name);
+			status = 1;
+		}
+	}
+
+	return status;
+}
@@ -0,0 +1,59 @@
+/*
+* Description: Adapter interface shared by the index benchmark driver and the
+* structure adapters (B-Trees, AVL, BST and hash tables).
+* Author: Breno Farias da Silva.
+* Date: 18/10/2026.
+*/
+
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include <stdbool.h>
+
+/*
+* Thin adapter over one index structure.
+* Each adapter_*.c file defines exactly one index_adapter, and the Makefile links
+* it with benchmark.c into its own executable, so structures whose sources share
+* symbol names (Node, btree_insert, hash_criar, ...) never meet in the same binary.
+* For the same reason each adapter #includes the .c file of its structure instead of
+* linking it: the structure is compiled only in its adapter's unit, and one pattern rule
+* builds every executable. The Makefile lists the included sources as prerequisites.
+*/
+typedef struct {
+	const char* name; // Structure name reported in the CSV output
+
+	/*
+	* Creates an empty index.
+	* capacity: maximum number of keys the run will insert (hash tables size on it).
+	* return: opaque handle to the index.
+	*/
+	void* (*create)(int capacity);
+
+	/*
+	* Inserts a key that is not yet present in the index.
+	*/
+	void (*insert)(void* index, int key);
+
+	/*
+	* Checks if a key exists in the index.
+	*/
+	bool (*contains)(void* index, int key);
+
+	/*
+	* Counts the keys in the closed interval [low, high].
+	* Structures without ordered access answer it with point lookups.
+	*/
+	int (*range)(void* index, int low, int high);
+
+	/*
+	* Destroys the index, freeing every resource it holds.
+	*/
+	void (*destroy)(void* index);
+} IndexAdapter;
+
+/*
+* The adapter linked into the current executable.
+*/
+extern const IndexAdapter index_adapter;
+
+#endif